@@ -21,10 +21,13 @@
  */
 
 #include <application/Application.hpp>
+#include <configuration/ParameterServer.hpp>
 
 namespace mic {
 namespace application {
 
+MIC_LOG_CATEGORY("mic.application.Application")
+
 Application::Application(std::string node_name_) : PropertyTree(node_name_),
 	number_of_iterations("number_of_iterations",0)
 {
@@ -73,10 +76,22 @@ void Application::run() {
 
 		} //: if! is paused & end of critical section
 
+		// Apply changes of the configuration - between iterations.
+		applyConfigurationChanges();
+
 		// Sleep.
 		APP_SLEEP();
 	}//: while
 }
 
+
+void Application::applyConfigurationChanges() {
+	if (!PARAM_SERVER->isConfigurationWatched())
+		return;
+	// Enter critical section - properties can be read by other threads (e.g. visualization).
+	APP_DATA_SYNCHRONIZATION_SCOPED_LOCK();
+	PARAM_SERVER->applyConfigurationChanges();
+}
+
 } /* namespace application */
 } /* namespace mic */
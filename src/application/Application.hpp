@@ -81,6 +81,11 @@ protected:
 	 */
 	virtual bool performSingleStep() = 0;
 
+	/*!
+	 * Applies the changes of the watched configuration file (if any) - called between iterations, in the critical section.
+	 */
+	void applyConfigurationChanges();
+
 };
 
 
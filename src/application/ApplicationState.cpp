@@ -29,6 +29,8 @@
 namespace mic {
 namespace application {
 
+MIC_LOG_CATEGORY("mic.application.ApplicationState")
+
 // Init application instance - as NULL.
 boost::atomic<ApplicationState*> ApplicationState::instance_(NULL);
 
@@ -94,8 +96,12 @@ double ApplicationState::Quit() {
 }
 
 void ApplicationState::setQuit() {
-	boost::mutex::scoped_lock lock(internal_data_synchronization_mutex);
-	quit_flag = true;
+	{
+		boost::mutex::scoped_lock lock(internal_data_synchronization_mutex);
+		quit_flag = true;
+	}
+	// Make sure that all messages logged so far are printed.
+	LOGGER->flush();
 }
 
 void ApplicationState::resetQuit() {
@@ -208,7 +214,6 @@ void ApplicationState::setSleepInterval(double sleep_interval_) {
 }
 
 double ApplicationState::getSleepInterval() {
-	boost::mutex::scoped_lock lock(internal_data_synchronization_mutex);
 	return application_sleep_interval;
 }
 
@@ -27,6 +27,7 @@
 #include <boost/thread/mutex.hpp>
 
 #include <configuration/PropertyTree.hpp>
+#include <configuration/AtomicProperty.hpp>
 #ifdef _WIN32
 #include <system_utils/windows_extras.hpp> // extra windows stuff
 #endif
@@ -68,7 +69,7 @@ public:
 	double Quit();
 
 	/*!
-	 * Change the state of quit flag to true.
+	 * Change the state of quit flag to true and flushes the logger (so asynchronously logged messages are not lost).
 	 * Access secured with scoped lock.
 	 */
 	void setQuit();
@@ -184,7 +185,7 @@ public:
 
 	/*!
 	 * Returns current value of time interval.
-	 * Access secured with scoped lock.
+	 * Wait-free (a single atomic load) - can be called from hot loops while other threads change the interval.
 	 * @return Sleep interval
 	 */
 	double getSleepInterval();
@@ -283,8 +284,9 @@ private:
 	 * Property: sleep interval in [ms], used for slowing/fastening the computations.
 	 * The interval belongs to the range between <1ms, 10s>.
 	 * Set to 1000.0 (1s) by default.
+	 * Atomic, so it can be read without locking while key handlers change it (changes are serialized by the internal mutex).
 	 */
-	mic::configuration::Property<double> application_sleep_interval;
+	mic::configuration::AtomicProperty<double> application_sleep_interval;
 
 	/*!
 	 * Private constructor. Sets default values of all flags (FALSE).
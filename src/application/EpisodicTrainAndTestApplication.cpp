@@ -67,6 +67,9 @@ void EpisodicTrainAndTestApplication::run() {
 
 		} //: if! is paused & end of critical section
 
+		// Apply changes of the configuration - between iterations.
+		applyConfigurationChanges();
+
 		// Sleep.
 		APP_SLEEP();
 	}//: while
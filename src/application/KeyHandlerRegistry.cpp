@@ -22,6 +22,10 @@
 
 #include <application/KeyHandlerRegistry.hpp>
 
+#include <logger/FlightRecorderOutput.hpp>
+
+#include <iostream>
+
 namespace mic {
   namespace application {
 
@@ -37,6 +41,8 @@ namespace mic {
       // Logger.
       registerKeyhandler(';', "; - increments the logger severity level", &KeyHandlerRegistry::keyhandlerIncrementLoggerLevel, this);
       registerKeyhandler('\'', "\' - decrements the logger severity level", &KeyHandlerRegistry::keyhandlerDecrementLoggerLevel, this);
+      registerKeyhandler('d', "d - sets the dynamic debug rules (type the rules and press ENTER)", &KeyHandlerRegistry::keyhandlerDynamicDebug, this);
+      registerKeyhandler('r', "r - dumps the records kept by the flight recorder", &KeyHandlerRegistry::keyhandlerDumpFlightRecorder, this);
 
       // Time keyhandlers.
       registerKeyhandler('-', "- - slows down the processing (multiplies the sleep interval by 1.5)", &KeyHandlerRegistry::keyhandlerSlowDown, this);
@@ -117,6 +123,39 @@ namespace mic {
       LOGGER->decrementSeverityLevel();
     }
 
+    void KeyHandlerRegistry::keyhandlerDynamicDebug(void) {
+      LOG(LTRACE) << "KeyHandlerRegistry::keyhandlerDynamicDebug";
+      if (!extendedInputMode) {
+        // Start collecting the rules.
+        changeInputMode('d');
+        LOG(LSTATUS) << "Current dynamic debug rules: \"" << mic::logger::LogSiteRegistry::getDynamicDebug() << "\"";
+        LOG(LSTATUS) << "Type new rules (e.g. KeyHandlerRegistry.cpp:* -*Episode*) and press ENTER (ESC - abort):";
+        return;
+      }//: if
+
+      std::string rules = changeInputMode('d');
+      if (rules == "-1") {
+        LOG(LSTATUS) << "Dynamic debug rules not changed";
+        return;
+      }//: if
+      mic::logger::LogSiteRegistry::setDynamicDebug(rules);
+      LOG(LSTATUS) << "Dynamic debug rules set to \"" << rules << "\"";
+    }
+
+    void KeyHandlerRegistry::keyhandlerDumpFlightRecorder(void) {
+      LOG(LTRACE) << "KeyHandlerRegistry::keyhandlerDumpFlightRecorder";
+      mic::logger::FlightRecorderOutput * recorder = mic::logger::FlightRecorderOutput::active();
+      if (!recorder) {
+        LOG(LSTATUS) << "Flight recorder is not active";
+        return;
+      }//: if
+      // Printed directly - logging the records would store them in the recorder again.
+      std::cout << "----------------------------------------------------------------\n";
+      std::cout << "Flight recorder " << recorder->getFilename() << ":\n";
+      recorder->dump(std::cout);
+      std::cout << "----------------------------------------------------------------" << std::endl;
+    }
+
     void KeyHandlerRegistry::keyhandlerToggleLearning(void) {
       LOG(LTRACE) << "KeyHandlerRegistry::keyhandlerToggleLearning";
       // Switch state of the learning mode.
@@ -149,6 +149,16 @@ namespace mic {
        */
       void keyhandlerDecrementLoggerLevel(void);
 
+      /*!
+       * Keyhandler: reads (in extended input mode) and sets the dynamic debug rules.
+       */
+      void keyhandlerDynamicDebug(void);
+
+      /*!
+       * Keyhandler: dumps the records kept by the flight recorder (if active).
+       */
+      void keyhandlerDumpFlightRecorder(void);
+
       /*!
        * Keyhandler: toggless learning on/off.
        */
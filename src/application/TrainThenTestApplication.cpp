@@ -58,6 +58,9 @@ void TrainThenTestApplication::run() {
 
 		} //: if! is paused & end of critical section
 
+		// Apply changes of the configuration - between iterations.
+		applyConfigurationChanges();
+
 		// Sleep.
 		APP_SLEEP();
 	}//: while
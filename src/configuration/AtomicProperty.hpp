@@ -0,0 +1,218 @@
+/*!
+ * Copyright (C) tkornuta, IBM Corporation 2015-2019
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+/*!
+ * \file AtomicProperty.hpp
+ * \brief Contains declaration of the property that can be read and changed concurrently, without locks.
+ * \author tkornuta
+ * \date Oct 17, 2026
+ */
+
+#ifndef SRC_CONFIGURATION_ATOMICPROPERTY_HPP_
+#define SRC_CONFIGURATION_ATOMICPROPERTY_HPP_
+
+#include <configuration/Property.hpp>
+
+#include <boost/atomic.hpp>
+#include <boost/cstdint.hpp>
+
+#include <cstring>
+#include <type_traits>
+
+namespace mic {
+namespace configuration {
+
+/*!
+ * \brief Property that can be read by hot loops while other threads (key handlers, control threads) change it - e.g. tunables of running applications.
+ * Values of up to 8 bytes are stored in a single atomic word, so reads are wait-free (a single load).
+ * Larger values are protected by a sequence lock - readers never block writers and retry only when they race with a write.
+ * Every write increments the version of the property, so readers can cheaply detect changes (see version()).
+ * The type must be trivially copyable.
+ * \author tkornuta
+ */
+template<class T, class Translator = typename DefaultTranslator<T>::type >
+class AtomicProperty : public PropertyInterface {
+	static_assert(std::is_trivially_copyable<T>::value, "AtomicProperty requires trivially copyable type");
+
+public:
+	/*!
+	 * Constructor, sets name and the initial value.
+	 * @param name_ Name of the property.
+	 * @param initializer_ Initial value.
+	 */
+	AtomicProperty(const std::string & name_, const T & initializer_ = T()) : PropertyInterface(name_), sequence(0) {
+		uint64_t buf[words_count];
+		toWords(initializer_, buf);
+		for (size_t i = 0; i < words_count; i++)
+			words[i].store(buf[i], boost::memory_order_relaxed);
+	}
+
+	/*!
+	 * Returns the current value.
+	 */
+	T load() const {
+		uint64_t buf[words_count];
+		if (words_count == 1)
+			buf[0] = words[0].load(boost::memory_order_acquire);
+		else {
+			for (;;) {
+				uint64_t seq = sequence.load(boost::memory_order_acquire);
+				// Odd sequence - write in progress.
+				if (seq & 1)
+					continue;
+				for (size_t i = 0; i < words_count; i++)
+					buf[i] = words[i].load(boost::memory_order_relaxed);
+				boost::atomic_thread_fence(boost::memory_order_acquire);
+				if (sequence.load(boost::memory_order_relaxed) == seq)
+					break;
+			}//: for
+		}//: else
+		T val;
+		std::memcpy(&val, buf, sizeof(T));
+		return val;
+	}
+
+	/*!
+	 * Sets the value and increments the version.
+	 * @param value_ New value.
+	 */
+	void store(const T & value_) {
+		uint64_t buf[words_count];
+		toWords(value_, buf);
+		if (words_count == 1) {
+			words[0].store(buf[0], boost::memory_order_release);
+			sequence.fetch_add(2, boost::memory_order_release);
+			return;
+		}//: if
+
+		// Make the sequence odd (wait for the concurrent writer to finish).
+		uint64_t seq = sequence.load(boost::memory_order_relaxed);
+		for (;;) {
+			if ((seq & 1) == 0) {
+				if (sequence.compare_exchange_weak(seq, seq + 1, boost::memory_order_acquire, boost::memory_order_relaxed))
+					break;
+			} else
+				seq = sequence.load(boost::memory_order_relaxed);
+		}//: for
+		boost::atomic_thread_fence(boost::memory_order_release);
+		for (size_t i = 0; i < words_count; i++)
+			words[i].store(buf[i], boost::memory_order_relaxed);
+		sequence.store(seq + 2, boost::memory_order_release);
+	}
+
+	/*!
+	 * Returns the number of writes of the property.
+	 */
+	uint64_t version() const {
+		return sequence.load(boost::memory_order_acquire) >> 1;
+	}
+
+	/*!
+	 * Access the data with function call syntax.
+	 */
+	T operator()() const {
+		return load();
+	}
+
+	/*!
+	 * Returns property value.
+	 */
+	operator T() const {
+		return load();
+	}
+
+	/*!
+	 * Sets new property value.
+	 * @param value_ New value to be set.
+	 */
+	AtomicProperty& operator=(T const & value_) {
+		store(value_);
+		return *this;
+	}
+
+	/*!
+	 * Sets value on a basis of a string (with the use of translator).
+	 * @param str String to retrieve value from.
+	 */
+	virtual void setValue(const std::string & str) {
+		store(Translator::fromStr(str));
+	}
+
+	/*!
+	 * Sets value on a basis of characters (with the use of translator).
+	 * @param str_ Characters to retrieve value from.
+	 * @param len_ Number of characters.
+	 */
+	virtual void setValue(const char * str_, size_t len_) {
+		store(translateChars<T, Translator>(str_, len_, 0));
+	}
+
+	/*!
+	 * Returns the canonical form of the value given by characters (with the use of translator), without storing it - so the version does not change.
+	 * @param str_ Characters from which value will be retrieved.
+	 * @param len_ Number of characters.
+	 */
+	virtual std::string canonicalValue(const char * str_, size_t len_) {
+		return Translator::toStr(translateChars<T, Translator>(str_, len_, 0));
+	}
+
+	/*!
+	 * Returns the string representing the current value.
+	 */
+	virtual std::string getValue() {
+		return Translator::toStr(load());
+	}
+
+	/*!
+	 * Formats the current value into the buffer of the caller (with the use of translator).
+	 * @param buf_ Buffer.
+	 * @param size_ Size of the buffer.
+	 * @return Length of the value - if greater than size_, the value was truncated.
+	 */
+	virtual size_t getValue(char * buf_, size_t size_) {
+		return formatChars<T, Translator>(load(), buf_, size_, 0);
+	}
+
+	/*!
+	 * Overloaded stream operator.
+	 */
+	friend std::ostream & operator<<(std::ostream & os, const AtomicProperty & prop) {
+		os << prop.load();
+		return os;
+	}
+
+private:
+	/// Number of words storing the value.
+	static const size_t words_count = (sizeof(T) + sizeof(uint64_t) - 1) / sizeof(uint64_t);
+
+	/*!
+	 * Copies the value into the words.
+	 */
+	static void toWords(const T & value_, uint64_t * buf_) {
+		std::memset(buf_, 0, words_count * sizeof(uint64_t));
+		std::memcpy(buf_, &value_, sizeof(T));
+	}
+
+	/// Sequence - even when the value is stable, odd during the write (of multi-word values). Incremented by 2 on every write.
+	boost::atomic<uint64_t> sequence;
+
+	/// Words storing the value.
+	boost::atomic<uint64_t> words[words_count];
+};
+
+} /* namespace configuration */
+} /* namespace mic */
+
+#endif /* SRC_CONFIGURATION_ATOMICPROPERTY_HPP_ */
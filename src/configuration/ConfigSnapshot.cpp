@@ -0,0 +1,291 @@
+/*!
+ * Copyright (C) tkornuta, IBM Corporation 2015-2019
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+/*!
+ * \file ConfigSnapshot.cpp
+ * \brief Contains definitions of methods of the binary snapshot of configuration files.
+ * \author tkornuta
+ * \date Oct 17, 2026
+ */
+
+#include <configuration/ConfigSnapshot.hpp>
+#include <configuration/JsonConfigReader.hpp>
+
+#include <logger/Log.hpp>
+
+#include <cstdio>
+#include <cstring>
+#include <cerrno>
+#include <vector>
+
+#include <fcntl.h>
+#include <unistd.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+
+namespace mic {
+namespace configuration {
+
+MIC_LOG_CATEGORY("mic.configuration.ConfigSnapshot")
+
+namespace {
+
+/// Magic number of the image.
+const char snapshot_magic[4] = { 'M', 'I', 'C', 'S' };
+
+/// Version of the format (changed whenever the layout changes).
+const uint32_t snapshot_version = 1;
+
+/*!
+ * Interns the string in the pool, returns its offset.
+ */
+uint32_t intern(const std::string & str_, std::string & pool_, std::map<std::string, uint32_t> & offsets_) {
+	std::map<std::string, uint32_t>::iterator it = offsets_.find(str_);
+	if (it != offsets_.end())
+		return it->second;
+	uint32_t offset = (uint32_t)pool_.size();
+	pool_ += str_;
+	offsets_.insert(std::make_pair(str_, offset));
+	return offset;
+}
+
+} /* namespace */
+
+
+/*!
+ * \brief Header of the image.
+ */
+struct ConfigSnapshot::Header {
+	/// Magic number.
+	char magic[4];
+
+	/// Version of the format.
+	uint32_t version;
+
+	/// Hash of the configuration file.
+	uint64_t content_hash;
+
+	/// Number of main nodes.
+	uint32_t node_count;
+
+	/// Number of values.
+	uint32_t value_count;
+
+	/// Size of the pool of strings.
+	uint32_t strings_size;
+
+	/// Padding.
+	uint32_t reserved;
+};
+
+
+/*!
+ * \brief Main node - its name and the range of its values.
+ */
+struct ConfigSnapshot::NodeEntry {
+	uint32_t name;
+	uint32_t name_length;
+	uint32_t first_value;
+	uint32_t value_count;
+};
+
+
+/*!
+ * \brief Value of a property - offsets of the name and value in the pool of strings.
+ */
+struct ConfigSnapshot::ValueEntry {
+	uint32_t key;
+	uint32_t key_length;
+	uint32_t value;
+	uint32_t value_length;
+};
+
+
+ConfigSnapshot::ConfigSnapshot() :
+	data(NULL), size(0), header(NULL), nodes(NULL), values(NULL), strings(NULL)
+{
+
+}
+
+
+ConfigSnapshot::~ConfigSnapshot() {
+	close();
+}
+
+
+uint64_t ConfigSnapshot::hash(const char * data_, size_t size_) {
+	uint64_t h = 14695981039346656037ULL;
+	for (size_t i = 0; i < size_; i++) {
+		h ^= (unsigned char)data_[i];
+		h *= 1099511628211ULL;
+	}//: for
+	return h;
+}
+
+
+bool ConfigSnapshot::compile(const std::string & text_, const std::string & config_filename_, const std::string & snapshot_filename_) {
+	JsonConfigReader::Document document;
+	JsonConfigReader(text_, config_filename_).read(document);
+
+	// Build the tables and the pool of strings.
+	std::vector<NodeEntry> node_table;
+	std::vector<ValueEntry> value_table;
+	std::string pool;
+	std::map<std::string, uint32_t> offsets;
+	for (size_t n = 0; n < document.size(); n++) {
+		NodeEntry node;
+		node.name = intern(document[n].first, pool, offsets);
+		node.name_length = (uint32_t)document[n].first.size();
+		node.first_value = (uint32_t)value_table.size();
+		node.value_count = (uint32_t)document[n].second.size();
+		node_table.push_back(node);
+		for (size_t v = 0; v < document[n].second.size(); v++) {
+			ValueEntry value;
+			value.key = intern(document[n].second[v].first, pool, offsets);
+			value.key_length = (uint32_t)document[n].second[v].first.size();
+			value.value = intern(document[n].second[v].second, pool, offsets);
+			value.value_length = (uint32_t)document[n].second[v].second.size();
+			value_table.push_back(value);
+		}//: for
+	}//: for
+
+	Header header;
+	std::memcpy(header.magic, snapshot_magic, sizeof(header.magic));
+	header.version = snapshot_version;
+	header.content_hash = hash(text_.data(), text_.size());
+	header.node_count = (uint32_t)node_table.size();
+	header.value_count = (uint32_t)value_table.size();
+	header.strings_size = (uint32_t)pool.size();
+	header.reserved = 0;
+
+	// Write under a temporary (unique) name, then rename - atomically replacing the outdated snapshot.
+	std::string tmp_filename = snapshot_filename_ + ".tmp." + std::to_string(::getpid());
+	FILE * file = std::fopen(tmp_filename.c_str(), "wb");
+	if (!file) {
+		LOG(LWARNING) << "Cannot write the configuration snapshot \"" << tmp_filename << "\": " << std::strerror(errno);
+		return false;
+	}//: if
+	bool ok = (std::fwrite(&header, sizeof(header), 1, file) == 1);
+	if (ok && !node_table.empty())
+		ok = (std::fwrite(&node_table[0], sizeof(NodeEntry), node_table.size(), file) == node_table.size());
+	if (ok && !value_table.empty())
+		ok = (std::fwrite(&value_table[0], sizeof(ValueEntry), value_table.size(), file) == value_table.size());
+	if (ok && !pool.empty())
+		ok = (std::fwrite(pool.data(), 1, pool.size(), file) == pool.size());
+	ok = (std::fclose(file) == 0) && ok;
+	if (!ok || (std::rename(tmp_filename.c_str(), snapshot_filename_.c_str()) != 0)) {
+		LOG(LWARNING) << "Cannot write the configuration snapshot \"" << snapshot_filename_ << "\": " << std::strerror(errno);
+		std::remove(tmp_filename.c_str());
+		return false;
+	}//: if
+
+	LOG(LINFO) << "Configuration snapshot \"" << snapshot_filename_ << "\" compiled: " << node_table.size() << " node(s), "
+			<< value_table.size() << " value(s), " << pool.size() << " bytes of strings";
+	return true;
+}
+
+
+bool ConfigSnapshot::open(const std::string & snapshot_filename_, uint64_t hash_) {
+	close();
+
+	int fd = ::open(snapshot_filename_.c_str(), O_RDONLY | O_CLOEXEC);
+	if (fd < 0)
+		return false;
+	struct stat st;
+	if ((::fstat(fd, &st) != 0) || ((size_t)st.st_size < sizeof(Header))) {
+		::close(fd);
+		return false;
+	}//: if
+	void * addr = ::mmap(NULL, (size_t)st.st_size, PROT_READ, MAP_PRIVATE, fd, 0);
+	::close(fd);
+	if (addr == MAP_FAILED)
+		return false;
+	data = (const char *)addr;
+	size = (size_t)st.st_size;
+
+	// Check the header and the layout.
+	header = (const Header *)data;
+	if ((std::memcmp(header->magic, snapshot_magic, sizeof(snapshot_magic)) != 0) || (header->version != snapshot_version)) {
+		LOG(LWARNING) << "Configuration snapshot \"" << snapshot_filename_ << "\" has unknown format";
+		close();
+		return false;
+	}//: if
+	if (header->content_hash != hash_) {
+		LOG(LINFO) << "Configuration snapshot \"" << snapshot_filename_ << "\" is outdated";
+		close();
+		return false;
+	}//: if
+	uint64_t expected = sizeof(Header) + (uint64_t)header->node_count * sizeof(NodeEntry) + (uint64_t)header->value_count * sizeof(ValueEntry) + header->strings_size;
+	if (expected != size) {
+		LOG(LWARNING) << "Configuration snapshot \"" << snapshot_filename_ << "\" is corrupted";
+		close();
+		return false;
+	}//: if
+	nodes = (const NodeEntry *)(data + sizeof(Header));
+	values = (const ValueEntry *)(nodes + header->node_count);
+	strings = (const char *)(values + header->value_count);
+
+	// Check the ranges - so loading never reads outside the image.
+	bool valid = true;
+	for (uint32_t n = 0; (n < header->node_count) && valid; n++)
+		valid = ((uint64_t)nodes[n].name + nodes[n].name_length <= header->strings_size) &&
+				((uint64_t)nodes[n].first_value + nodes[n].value_count <= header->value_count);
+	for (uint32_t v = 0; (v < header->value_count) && valid; v++)
+		valid = ((uint64_t)values[v].key + values[v].key_length <= header->strings_size) &&
+				((uint64_t)values[v].value + values[v].value_length <= header->strings_size);
+	if (!valid) {
+		LOG(LWARNING) << "Configuration snapshot \"" << snapshot_filename_ << "\" is corrupted";
+		close();
+		return false;
+	}//: if
+
+	LOG(LINFO) << "Configuration snapshot \"" << snapshot_filename_ << "\" mapped";
+	return true;
+}
+
+
+void ConfigSnapshot::close() {
+	if (data)
+		::munmap(const_cast<char *>(data), size);
+	data = NULL;
+	size = 0;
+	header = NULL;
+	nodes = NULL;
+	values = NULL;
+	strings = NULL;
+}
+
+
+void ConfigSnapshot::load(const std::map<std::string, PropertyTree*> & registry_) const {
+	if (!data)
+		return;
+	std::string name;
+	for (uint32_t n = 0; n < header->node_count; n++) {
+		name.assign(strings + nodes[n].name, nodes[n].name_length);
+		std::map<std::string, PropertyTree*>::const_iterator it = registry_.find(name);
+		if (it == registry_.end()) {
+			LOG(LERROR) << "Object \"" << name << "\" appearing in the loaded config file was not found in the property tree registry";
+			continue;
+		}//: if
+		const ValueEntry * value = values + nodes[n].first_value;
+		for (uint32_t v = 0; v < nodes[n].value_count; v++, value++) {
+			name.assign(strings + value->key, value->key_length);
+			it->second->loadPropertyValue(name, strings + value->value, value->value_length);
+		}//: for
+	}//: for
+}
+
+} /* namespace configuration */
+} /* namespace mic */
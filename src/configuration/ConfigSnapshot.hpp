@@ -0,0 +1,133 @@
+/*!
+ * Copyright (C) tkornuta, IBM Corporation 2015-2019
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+/*!
+ * \file ConfigSnapshot.hpp
+ * \brief Contains declaration of the binary snapshot of configuration files.
+ * \author tkornuta
+ * \date Oct 17, 2026
+ */
+
+#ifndef SRC_CONFIGURATION_CONFIGSNAPSHOT_HPP_
+#define SRC_CONFIGURATION_CONFIGSNAPSHOT_HPP_
+
+#include <configuration/PropertyTree.hpp>
+
+#include <map>
+#include <string>
+#include <stdint.h>
+
+namespace mic {
+namespace configuration {
+
+/*!
+ * \brief Compact binary image of the configuration file, memory-mapped and loaded without parsing.
+ * The image consists of a header (with the hash of the JSON file it was compiled from), a table of main nodes,
+ * a table of their values and a pool of interned (deduplicated) strings - the names of nodes and properties and the unescaped values,
+ * which are passed to the properties straight from the mapped file (see PropertyInterface::setValue(const char*, size_t)).
+ * Images are compiled next to the JSON file (see snapshotName()) and are used only if the hash of the JSON file matches.
+ * \author tkornuta
+ */
+class ConfigSnapshot {
+public:
+	/*!
+	 * Constructor. Creates a closed snapshot.
+	 */
+	ConfigSnapshot();
+
+	/*!
+	 * Destructor. Unmaps the image.
+	 */
+	~ConfigSnapshot();
+
+	/*!
+	 * Returns the (64-bit FNV-1a) hash of the contents of the configuration file.
+	 * @param data_ Contents of the file.
+	 * @param size_ Size of the contents.
+	 */
+	static uint64_t hash(const char * data_, size_t size_);
+
+	/*!
+	 * Returns the name of the snapshot of the configuration file.
+	 * @param config_filename_ Name of the configuration file.
+	 */
+	static std::string snapshotName(const std::string & config_filename_) { return config_filename_ + ".snapshot"; }
+
+	/*!
+	 * Compiles the configuration into the snapshot. The file is written under a temporary name and renamed,
+	 * so processes started concurrently never see an incomplete image.
+	 * Syntax errors are reported by throwing boost::property_tree::json_parser_error (see JsonConfigReader).
+	 * @param text_ Contents of the configuration file.
+	 * @param config_filename_ Name of the configuration file (used in error messages).
+	 * @param snapshot_filename_ Name of the snapshot.
+	 * @return True if the snapshot was written.
+	 */
+	static bool compile(const std::string & text_, const std::string & config_filename_, const std::string & snapshot_filename_);
+
+	/*!
+	 * Maps the snapshot - checks its format and whether it was compiled from the file with the given hash.
+	 * @param snapshot_filename_ Name of the snapshot.
+	 * @param hash_ Hash of the contents of the configuration file.
+	 * @return True if the snapshot is valid and up to date.
+	 */
+	bool open(const std::string & snapshot_filename_, uint64_t hash_);
+
+	/*!
+	 * Unmaps the snapshot.
+	 */
+	void close();
+
+	/*!
+	 * Returns true if the snapshot is mapped.
+	 */
+	bool isOpen() const { return data != NULL; }
+
+	/*!
+	 * Loads the values of properties of the registered property trees - as JsonConfigReader::load() does.
+	 * @param registry_ Registered property trees (node name - tree).
+	 */
+	void load(const std::map<std::string, PropertyTree*> & registry_) const;
+
+private:
+	struct Header;
+	struct NodeEntry;
+	struct ValueEntry;
+
+	ConfigSnapshot(const ConfigSnapshot &);
+	ConfigSnapshot & operator=(const ConfigSnapshot &);
+
+	/// Mapped image.
+	const char * data;
+
+	/// Size of the image.
+	size_t size;
+
+	/// Header of the image.
+	const Header * header;
+
+	/// Table of main nodes.
+	const NodeEntry * nodes;
+
+	/// Table of values.
+	const ValueEntry * values;
+
+	/// Pool of strings.
+	const char * strings;
+};
+
+} /* namespace configuration */
+} /* namespace mic */
+
+#endif /* SRC_CONFIGURATION_CONFIGSNAPSHOT_HPP_ */
@@ -0,0 +1,411 @@
+/*!
+ * Copyright (C) tkornuta, IBM Corporation 2015-2019
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+/*!
+ * \file JsonConfigReader.cpp
+ * \brief Contains definitions of methods of the streaming reader of JSON configuration files.
+ * \author tkornuta
+ * \date Oct 17, 2026
+ */
+
+#include <configuration/JsonConfigReader.hpp>
+
+#include <logger/Log.hpp>
+
+#include <boost/property_tree/json_parser.hpp>
+
+#include <algorithm>
+#include <cstdlib>
+#include <cstring>
+
+namespace mic {
+namespace configuration {
+
+MIC_LOG_CATEGORY("mic.configuration.JsonConfigReader")
+
+namespace {
+
+/// Maximal nesting depth of skipped values.
+const int max_depth = 256;
+
+/*!
+ * Appends the code point encoded in UTF-8.
+ */
+void appendUtf8(std::string & out_, unsigned long cp_) {
+	if (cp_ < 0x80)
+		out_ += (char)cp_;
+	else if (cp_ < 0x800) {
+		out_ += (char)(0xC0 | (cp_ >> 6));
+		out_ += (char)(0x80 | (cp_ & 0x3F));
+	} else if (cp_ < 0x10000) {
+		out_ += (char)(0xE0 | (cp_ >> 12));
+		out_ += (char)(0x80 | ((cp_ >> 6) & 0x3F));
+		out_ += (char)(0x80 | (cp_ & 0x3F));
+	} else {
+		out_ += (char)(0xF0 | (cp_ >> 18));
+		out_ += (char)(0x80 | ((cp_ >> 12) & 0x3F));
+		out_ += (char)(0x80 | ((cp_ >> 6) & 0x3F));
+		out_ += (char)(0x80 | (cp_ & 0x3F));
+	}//: else
+}
+
+/*!
+ * Returns true if the character is a decimal digit.
+ */
+inline bool isDigit(char c_) {
+	return (c_ >= '0') && (c_ <= '9');
+}
+
+} /* namespace */
+
+
+JsonConfigReader::JsonConfigReader(const std::string & text_, const std::string & filename_) :
+	begin(text_.data()), pos(text_.data()), end(text_.data() + text_.size()), filename(filename_)
+{
+
+}
+
+
+void JsonConfigReader::validate() {
+	pos = begin;
+	parseDocument(NULL);
+}
+
+
+void JsonConfigReader::load(const std::map<std::string, PropertyTree*> & registry_) {
+	Document document;
+	read(document);
+	load(document, registry_);
+}
+
+
+void JsonConfigReader::reload(const std::map<std::string, PropertyTree*> & registry_, ChangedProperties & changed_) {
+	Document document;
+	read(document);
+	reload(document, registry_, changed_);
+}
+
+
+void JsonConfigReader::read(Document & document_) {
+	pos = begin;
+	document_.clear();
+	parseDocument(&document_);
+}
+
+
+void JsonConfigReader::load(const Document & document_, const std::map<std::string, PropertyTree*> & registry_) {
+	apply(document_, registry_, NULL);
+}
+
+
+void JsonConfigReader::reload(const Document & document_, const std::map<std::string, PropertyTree*> & registry_, ChangedProperties & changed_) {
+	apply(document_, registry_, &changed_);
+}
+
+
+void JsonConfigReader::apply(const Document & document_, const std::map<std::string, PropertyTree*> & registry_, ChangedProperties * changed_) {
+	for (Document::const_iterator node = document_.begin(); node != document_.end(); ++node) {
+		std::map<std::string, PropertyTree*>::const_iterator it = registry_.find(node->first);
+		if (it == registry_.end()) {
+			LOG(LERROR) << "Object \"" << node->first << "\" appearing in the loaded config file was not found in the property tree registry";
+			continue;
+		}//: if
+		for (NodeValues::const_iterator value = node->second.begin(); value != node->second.end(); ++value) {
+			if (!changed_)
+				it->second->loadPropertyValue(value->first, value->second.data(), value->second.size());
+			else if (it->second->updatePropertyValue(value->first, value->second.data(), value->second.size()))
+				(*changed_)[it->second].push_back(value->first);
+		}//: for
+	}//: for
+}
+
+
+void JsonConfigReader::parseDocument(Document * document_) {
+	expect('{');
+	skipWhitespace();
+	if ((pos < end) && (*pos == '}'))
+		pos++;
+	else {
+		for (;;) {
+			skipWhitespace();
+			parseString(key_buffer);
+			expect(':');
+			skipWhitespace();
+
+			if ((pos < end) && (*pos == '{')) {
+				if (document_) {
+					document_->push_back(std::make_pair(key_buffer, NodeValues()));
+					parseNode(document_->back().first, &document_->back().second);
+				} else
+					parseNode(key_buffer, NULL);
+			} else {
+				if (document_)
+					LOG(LWARNING) << "Node \"" << key_buffer << "\" in the loaded config file is not an object";
+				skipValue();
+			}//: else
+
+			skipWhitespace();
+			if ((pos < end) && (*pos == ',')) {
+				pos++;
+				continue;
+			}//: if
+			expect('}');
+			break;
+		}//: for
+	}//: else
+
+	skipWhitespace();
+	if (pos != end)
+		fail("garbage after data");
+}
+
+
+void JsonConfigReader::parseNode(const std::string & node_name_, NodeValues * values_) {
+	expect('{');
+	skipWhitespace();
+	if ((pos < end) && (*pos == '}')) {
+		pos++;
+		return;
+	}//: if
+	for (;;) {
+		skipWhitespace();
+		parseString(key_buffer);
+		expect(':');
+		skipWhitespace();
+		if (pos >= end)
+			fail("unexpected end of input");
+
+		const char * str;
+		size_t len;
+		if ((*pos == '{') || (*pos == '[')) {
+			if (values_)
+				LOG(LWARNING) << "Object \"" << node_name_ << "\": property \"" << key_buffer << "\" is not a simple value - skipped";
+			skipValue();
+		} else {
+			if (*pos == '"')
+				parseString(value_buffer, str, len);
+			else
+				parseToken(str, len);
+			if (values_)
+				values_->push_back(std::make_pair(key_buffer, std::string(str, len)));
+		}//: else
+
+		skipWhitespace();
+		if ((pos < end) && (*pos == ',')) {
+			pos++;
+			continue;
+		}//: if
+		expect('}');
+		return;
+	}//: for
+}
+
+
+void JsonConfigReader::parseString(std::string & buffer_) {
+	const char * str;
+	size_t len;
+	parseString(buffer_, str, len);
+	if (str != buffer_.data())
+		buffer_.assign(str, len);
+}
+
+
+void JsonConfigReader::parseString(std::string & buffer_, const char *& str_, size_t & len_) {
+	if ((pos >= end) || (*pos != '"'))
+		fail("expected string");
+	pos++;
+
+	// Fast path - no escapes, the string is used in place.
+	const char * start = pos;
+	while ((pos < end) && (*pos != '"') && (*pos != '\\')) {
+		if ((unsigned char)*pos < 0x20)
+			fail("invalid code sequence");
+		pos++;
+	}//: while
+	if (pos >= end)
+		fail("unterminated string");
+	if (*pos == '"') {
+		str_ = start;
+		len_ = pos - start;
+		pos++;
+		return;
+	}//: if
+
+	// Escapes - unescape into the buffer.
+	buffer_.assign(start, pos - start);
+	while (pos < end) {
+		char c = *pos++;
+		if (c == '"') {
+			str_ = buffer_.data();
+			len_ = buffer_.size();
+			return;
+		}//: if
+		if ((unsigned char)c < 0x20)
+			fail("invalid code sequence");
+		if (c != '\\') {
+			buffer_ += c;
+			continue;
+		}//: if
+		if (pos >= end)
+			break;
+		c = *pos++;
+		switch (c) {
+		case '"': buffer_ += '"'; break;
+		case '\\': buffer_ += '\\'; break;
+		case '/': buffer_ += '/'; break;
+		case 'b': buffer_ += '\b'; break;
+		case 'f': buffer_ += '\f'; break;
+		case 'n': buffer_ += '\n'; break;
+		case 'r': buffer_ += '\r'; break;
+		case 't': buffer_ += '\t'; break;
+		case 'u': {
+			unsigned long cp = 0;
+			for (int i = 0; i < 4; i++) {
+				if (pos >= end)
+					fail("invalid escape sequence");
+				char h = *pos++;
+				cp <<= 4;
+				if (isDigit(h))
+					cp |= h - '0';
+				else if ((h >= 'a') && (h <= 'f'))
+					cp |= h - 'a' + 10;
+				else if ((h >= 'A') && (h <= 'F'))
+					cp |= h - 'A' + 10;
+				else
+					fail("invalid escape sequence");
+			}//: for
+			// Combine the surrogate pair.
+			if ((cp >= 0xD800) && (cp < 0xDC00) && (end - pos >= 6) && (pos[0] == '\\') && (pos[1] == 'u')) {
+				unsigned long low = std::strtoul(std::string(pos + 2, 4).c_str(), NULL, 16);
+				if ((low >= 0xDC00) && (low < 0xE000)) {
+					cp = 0x10000 + ((cp - 0xD800) << 10) + (low - 0xDC00);
+					pos += 6;
+				}//: if
+			}//: if
+			appendUtf8(buffer_, cp);
+			break;
+		}
+		default:
+			fail("invalid escape sequence");
+		}//: switch
+	}//: while
+	fail("unterminated string");
+}
+
+
+void JsonConfigReader::parseToken(const char *& str_, size_t & len_) {
+	const char * start = pos;
+	if ((*pos == '-') || isDigit(*pos)) {
+		// Number: -?(0|[1-9][0-9]*)(.[0-9]+)?([eE][+-]?[0-9]+)?
+		if (*pos == '-')
+			pos++;
+		if ((pos < end) && (*pos == '0'))
+			pos++;
+		else if ((pos < end) && isDigit(*pos)) {
+			while ((pos < end) && isDigit(*pos))
+				pos++;
+		} else
+			fail("expected digits");
+		if ((pos < end) && (*pos == '.')) {
+			pos++;
+			if ((pos >= end) || !isDigit(*pos))
+				fail("need at least one digit after '.'");
+			while ((pos < end) && isDigit(*pos))
+				pos++;
+		}//: if
+		if ((pos < end) && ((*pos == 'e') || (*pos == 'E'))) {
+			pos++;
+			if ((pos < end) && ((*pos == '+') || (*pos == '-')))
+				pos++;
+			if ((pos >= end) || !isDigit(*pos))
+				fail("need at least one digit in exponent");
+			while ((pos < end) && isDigit(*pos))
+				pos++;
+		}//: if
+	} else {
+		static const char * const literals[] = { "true", "false", "null" };
+		bool found = false;
+		for (size_t i = 0; (i < 3) && !found; i++) {
+			size_t n = std::strlen(literals[i]);
+			if (((size_t)(end - pos) >= n) && (std::equal(literals[i], literals[i] + n, pos))) {
+				pos += n;
+				found = true;
+			}//: if
+		}//: for
+		if (!found)
+			fail("expected value");
+	}//: else
+	str_ = start;
+	len_ = pos - start;
+}
+
+
+void JsonConfigReader::skipValue(int depth_) {
+	if (depth_ > max_depth)
+		fail("nesting too deep");
+	skipWhitespace();
+	if (pos >= end)
+		fail("unexpected end of input");
+
+	if (*pos == '"') {
+		const char * str;
+		size_t len;
+		parseString(value_buffer, str, len);
+	} else if ((*pos == '{') || (*pos == '[')) {
+		char close = (*pos == '{') ? '}' : ']';
+		pos++;
+		skipWhitespace();
+		if ((pos < end) && (*pos == close)) {
+			pos++;
+			return;
+		}//: if
+		for (;;) {
+			if (close == '}') {
+				skipWhitespace();
+				parseString(key_buffer);
+				expect(':');
+			}//: if
+			skipValue(depth_ + 1);
+			skipWhitespace();
+			if ((pos < end) && (*pos == ',')) {
+				pos++;
+				continue;
+			}//: if
+			expect(close);
+			return;
+		}//: for
+	} else {
+		const char * str;
+		size_t len;
+		parseToken(str, len);
+	}//: else
+}
+
+
+void JsonConfigReader::expect(char c_) {
+	skipWhitespace();
+	if ((pos >= end) || (*pos != c_))
+		fail(std::string("expected '") + c_ + "'");
+	pos++;
+}
+
+
+void JsonConfigReader::fail(const std::string & msg_) const {
+	unsigned long line = 1 + std::count(begin, pos, '\n');
+	throw boost::property_tree::json_parser_error(msg_, filename, line);
+}
+
+} /* namespace configuration */
+} /* namespace mic */
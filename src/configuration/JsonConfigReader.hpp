@@ -0,0 +1,185 @@
+/*!
+ * Copyright (C) tkornuta, IBM Corporation 2015-2019
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+/*!
+ * \file JsonConfigReader.hpp
+ * \brief Contains declaration of a streaming reader of JSON configuration files, binding the values directly into registered properties.
+ * \author tkornuta
+ * \date Oct 17, 2026
+ */
+
+#ifndef SRC_CONFIGURATION_JSONCONFIGREADER_HPP_
+#define SRC_CONFIGURATION_JSONCONFIGREADER_HPP_
+
+#include <configuration/PropertyTree.hpp>
+
+#include <map>
+#include <string>
+#include <vector>
+
+namespace mic {
+namespace configuration {
+
+/*!
+ * \brief Single-pass (SAX-like) reader of JSON configuration files.
+ * The document is tokenized once: the values of members of its main nodes are gathered per node (see Document) - no intermediate
+ * property tree is built. The values are passed to the properties (see PropertyInterface::setValue(const char*, size_t)) only after
+ * the whole document was parsed without errors, so an invalid file does not change any property.
+ * Numbers, true, false and null are passed as they are written in the file (as boost::property_tree did).
+ * Syntax errors are reported by throwing boost::property_tree::json_parser_error (with the line number).
+ * \author tkornuta
+ */
+class JsonConfigReader {
+public:
+	/// Names of the changed properties of every property tree (see reload()).
+	typedef std::map<PropertyTree*, std::vector<std::string> > ChangedProperties;
+
+	/// Values (property name - value) of a main node.
+	typedef std::vector<std::pair<std::string, std::string> > NodeValues;
+
+	/// Main nodes of the document (node name - values), in the order of appearance (see read()).
+	typedef std::vector<std::pair<std::string, NodeValues> > Document;
+
+	/*!
+	 * Constructor.
+	 * @param text_ Contents of the configuration file (must outlive the reader).
+	 * @param filename_ Name of the file (used in error messages).
+	 */
+	JsonConfigReader(const std::string & text_, const std::string & filename_);
+
+	/*!
+	 * Checks the syntax of the document without loading any values.
+	 */
+	void validate();
+
+	/*!
+	 * Reads the document and loads the values of properties of the registered property trees (see load(const Document&, ...)).
+	 * @param registry_ Registered property trees (node name - tree).
+	 */
+	void load(const std::map<std::string, PropertyTree*> & registry_);
+
+	/*!
+	 * Reads the document and sets only the properties whose values differ from the current ones (see reload(const Document&, ...)).
+	 * @param registry_ Registered property trees (node name - tree).
+	 * @param changed_ Returned names of the changed properties of every tree.
+	 */
+	void reload(const std::map<std::string, PropertyTree*> & registry_, ChangedProperties & changed_);
+
+	/*!
+	 * Reads the values of all main nodes of the document, without loading them.
+	 * @param document_ Returned main nodes with their values (strings unescaped).
+	 */
+	void read(Document & document_);
+
+	/*!
+	 * Loads the values of the read document into the properties of the registered property trees.
+	 * Nodes that do not match any registered tree are skipped (and reported).
+	 * @param document_ Read document (see read()).
+	 * @param registry_ Registered property trees (node name - tree).
+	 */
+	static void load(const Document & document_, const std::map<std::string, PropertyTree*> & registry_);
+
+	/*!
+	 * Sets only the properties whose values in the read document differ from the current ones (see PropertyTree::updatePropertyValue()).
+	 * @param document_ Read document (see read()).
+	 * @param registry_ Registered property trees (node name - tree).
+	 * @param changed_ Returned names of the changed properties of every tree.
+	 */
+	static void reload(const Document & document_, const std::map<std::string, PropertyTree*> & registry_, ChangedProperties & changed_);
+
+private:
+	/*!
+	 * Reads the document - stores the values of its main nodes when document_ is not NULL (otherwise only checks the syntax).
+	 */
+	void parseDocument(Document * document_);
+
+	/*!
+	 * Reads the object of the main node and stores the values of its members (when values_ is not NULL).
+	 */
+	void parseNode(const std::string & node_name_, NodeValues * values_);
+
+	/*!
+	 * Passes the values of the document to the registered property trees - loads them or, when changed_ is not NULL,
+	 * updates them and records the changes.
+	 */
+	static void apply(const Document & document_, const std::map<std::string, PropertyTree*> & registry_, ChangedProperties * changed_);
+
+	/*!
+	 * Reads the string (pos at the opening quote). Strings without escapes point into the text, others are unescaped into buffer_.
+	 * @param buffer_ Buffer for unescaped strings.
+	 * @param str_ Returned beginning of the string.
+	 * @param len_ Returned length of the string.
+	 */
+	void parseString(std::string & buffer_, const char *& str_, size_t & len_);
+
+	/*!
+	 * Reads the string into the buffer.
+	 */
+	void parseString(std::string & buffer_);
+
+	/*!
+	 * Reads the number or the literal (true, false, null).
+	 * @param str_ Returned beginning of the token.
+	 * @param len_ Returned length of the token.
+	 */
+	void parseToken(const char *& str_, size_t & len_);
+
+	/*!
+	 * Skips the value of any type.
+	 * @param depth_ Current nesting depth.
+	 */
+	void skipValue(int depth_ = 0);
+
+	/*!
+	 * Skips the white spaces.
+	 */
+	void skipWhitespace() {
+		while ((pos < end) && ((*pos == ' ') || (*pos == '\t') || (*pos == '\n') || (*pos == '\r')))
+			pos++;
+	}
+
+	/*!
+	 * Skips the white spaces and consumes the expected character.
+	 */
+	void expect(char c_);
+
+	/*!
+	 * Throws the parse error at the current position.
+	 */
+	[[noreturn]] void fail(const std::string & msg_) const;
+
+	/// Beginning of the text.
+	const char * begin;
+
+	/// Current position.
+	const char * pos;
+
+	/// End of the text.
+	const char * end;
+
+	/// Name of the file.
+	std::string filename;
+
+	/// Buffer for the keys.
+	std::string key_buffer;
+
+	/// Buffer for the unescaped values.
+	std::string value_buffer;
+};
+
+} /* namespace configuration */
+} /* namespace mic */
+
+#endif /* SRC_CONFIGURATION_JSONCONFIGREADER_HPP_ */
@@ -0,0 +1,88 @@
+/*!
+ * Copyright (C) tkornuta, IBM Corporation 2015-2019
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+/*!
+ * \file LoggerConfiguration.cpp
+ * \brief Contains definition of methods of the LoggerConfiguration class.
+ * \author tkornuta
+ * \date Oct 17, 2026
+ */
+
+#include <configuration/LoggerConfiguration.hpp>
+
+#include <logger/Log.hpp>
+
+namespace mic {
+namespace configuration {
+
+MIC_LOG_CATEGORY("mic.configuration.LoggerConfiguration")
+
+LoggerConfiguration::LoggerConfiguration() : PropertyTree("logger"),
+	dynamic_debug("dynamic_debug", ""),
+	categories("categories", ""),
+	duplicate_window("duplicate_window", 0),
+	applied_duplicate_window(0)
+{
+	// Register properties - so their values can be overridden (read from the configuration file).
+	registerProperty(dynamic_debug);
+	registerProperty(categories);
+	registerProperty(duplicate_window);
+}
+
+
+void LoggerConfiguration::initializePropertyDependentVariables() {
+	std::string rules = dynamic_debug;
+	if (rules != applied_dynamic_debug) {
+		mic::logger::LogSiteRegistry::setDynamicDebug(rules);
+		applied_dynamic_debug = rules;
+		LOG(LINFO) << "Dynamic debug rules set to \"" << rules << "\"";
+	}//: if
+
+	std::string levels = categories;
+	if (levels != applied_categories) {
+		// Remove the levels of the categories named by the previous value - the new value replaces all of them.
+		std::string reset;
+		size_t pos = 0;
+		while (pos < applied_categories.size()) {
+			size_t end = applied_categories.find_first_of(" \t,;", pos);
+			if (end == std::string::npos)
+				end = applied_categories.size();
+			size_t eq = applied_categories.find('=', pos);
+			if ((eq != std::string::npos) && (eq < end))
+				reset += applied_categories.substr(pos, eq - pos) + "=INHERIT ";
+			pos = end + 1;
+		}//: while
+		mic::logger::LogCategory::setLevels(reset);
+		applied_categories = levels;
+
+		if (mic::logger::LogCategory::setLevels(levels))
+			LOG(LINFO) << "Levels of logging categories set to \"" << levels << "\"";
+		else
+			LOG(LWARNING) << "Invalid levels of logging categories \"" << levels << "\" (expected list of category=LEVEL pairs)";
+	}//: if
+
+	unsigned int window = duplicate_window;
+	if (window != applied_duplicate_window) {
+		LOGGER->setDuplicateSuppression(window);
+		applied_duplicate_window = window;
+		if (window > 0)
+			LOG(LINFO) << "Suppression of duplicate messages enabled (window " << window << " ms)";
+		else
+			LOG(LINFO) << "Suppression of duplicate messages disabled";
+	}//: if
+}
+
+} /* namespace configuration */
+} /* namespace mic */
@@ -0,0 +1,81 @@
+/*!
+ * Copyright (C) tkornuta, IBM Corporation 2015-2019
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+/*!
+ * \file LoggerConfiguration.hpp
+ * \brief Contains declaration of the LoggerConfiguration class.
+ * \author tkornuta
+ * \date Oct 17, 2026
+ */
+
+#ifndef SRC_CONFIGURATION_LOGGERCONFIGURATION_HPP_
+#define SRC_CONFIGURATION_LOGGERCONFIGURATION_HPP_
+
+#include <configuration/PropertyTree.hpp>
+
+namespace mic {
+namespace configuration {
+
+/*!
+ * \brief Properties of the logger, read from the "logger" node of the configuration file.
+ * Created by the ParameterServer when parsing the application parameters.
+ * \author tkornuta
+ */
+class LoggerConfiguration : public PropertyTree {
+public:
+	/*!
+	 * Constructor. Registers properties.
+	 */
+	LoggerConfiguration();
+
+	/*!
+	 * Applies the logger properties that differ from the applied ones - including the empty (zero) values, so a reloaded
+	 * configuration can remove the rules, the levels of categories and the suppression of duplicates.
+	 */
+	virtual void initializePropertyDependentVariables();
+
+protected:
+	/*!
+	 * Property: dynamic debug rules, enabling/disabling individual log sites (see LogSiteRegistry::setDynamicDebug), e.g. "KeyHandlerRegistry.cpp:* -*Episode*".
+	 */
+	Property<std::string> dynamic_debug;
+
+	/*!
+	 * Property: levels of logging categories (see LogCategory::setLevels), e.g. "mic.configuration=WARNING mic.application=DEBUG".
+	 * A level below the level of an output (DEBUG above) reaches only the outputs accepting forced records, e.g. the console;
+	 * other outputs apply their own levels, so for them the category levels can only make logging quieter.
+	 */
+	Property<std::string> categories;
+
+	/*!
+	 * Property: window of suppression of identical consecutive messages of a call site in ms (see Logger::setDuplicateSuppression), 0 - disabled.
+	 */
+	Property<unsigned int> duplicate_window;
+
+private:
+	/// Applied dynamic debug rules.
+	std::string applied_dynamic_debug;
+
+	/// Applied levels of logging categories.
+	std::string applied_categories;
+
+	/// Applied window of suppression of duplicates.
+	unsigned int applied_duplicate_window;
+};
+
+} /* namespace configuration */
+} /* namespace mic */
+
+#endif /* SRC_CONFIGURATION_LOGGERCONFIGURATION_HPP_ */
@@ -21,12 +21,26 @@
  */
 
 #include <configuration/ParameterServer.hpp>
+#include <configuration/JsonConfigReader.hpp>
 
 #include <boost/property_tree/json_parser.hpp>
 
+#include <fstream>
+#include <sstream>
+#include <iterator>
+#include <cstring>
+#include <cerrno>
+
+#ifdef __linux__
+#include <sys/inotify.h>
+#include <unistd.h>
+#endif
+
 namespace mic {
 namespace configuration {
 
+MIC_LOG_CATEGORY("mic.configuration.ParameterServer")
+
 // Initialize application instance - as NULL.
 boost::atomic<ParameterServer*> ParameterServer::instance_(NULL);
 
@@ -66,11 +80,19 @@ ParameterServer* ParameterServer::getInstance() {
 }
 
 ParameterServer::ParameterServer()
-: program_options("Allowed options") 
+: program_options("Allowed options"), logger_configuration(NULL), watch_fd(-1)
 {
 	// TODO Auto-generated constructor stub
 }
 
+ParameterServer::~ParameterServer() {
+#ifdef __linux__
+	if (watch_fd >= 0)
+		::close(watch_fd);
+#endif
+	delete logger_configuration;
+}
+
 void ParameterServer::print(boost::property_tree::ptree const& pt_)
 {
     LOG(LDEBUG)<< "Properties loaded from config file (raw):";
@@ -83,6 +105,12 @@ void ParameterServer::print(boost::property_tree::ptree const& pt_)
 
 const boost::property_tree::ptree & ParameterServer::returnNode(std::string node_name_)
 {
+	// Build the tree on first use.
+	if (config_tree.empty() && !config_text.empty()) {
+		std::istringstream is(config_text);
+		read_json(is, config_tree);
+	}//: if
+
 	// Try to find the node.
     for (ptree::const_iterator it = config_tree.begin(); it != config_tree.end(); ++it) {
     	if (it->first == node_name_) {
@@ -98,6 +126,10 @@ const boost::property_tree::ptree & ParameterServer::returnNode(std::string node
 
 
 void ParameterServer::parseApplicationParameters(int argc, char* argv[]) {
+	// Create the logger configuration - it registers itself, so the "logger" node can be loaded from the configuration file.
+	if (!logger_configuration)
+		logger_configuration = new LoggerConfiguration();
+
 	// Extract application (binary file) name.
 	std::string tmp = std::string(argv[0]);
 	application_name = tmp.substr(tmp.find_last_of("/\\")+1);
@@ -119,6 +151,8 @@ void ParameterServer::parseApplicationParameters(int argc, char* argv[]) {
 		("load-config,l", po::value<std::string>(&existing_config_name)->default_value(default_config_name.c_str()), "(L)oad configuration from given JSON file")
 		("create-config,c", "(C)reate default configuration JSON file")
 		("set-logger-level,s", po::value<int>(&log_lvl)->default_value(3), "(S)et logger severity level")
+		("watch-config,w", "(W)atch the configuration file and apply its changes while running")
+		("use-snapshot,b", "Load configuration from its (b)inary snapshot, compiled next to the JSON file when missing or outdated")
 	;
 
 	// Variables map.
@@ -166,12 +200,8 @@ void ParameterServer::parseApplicationParameters(int argc, char* argv[]) {
 	}//: create config
 
 	try {
-		read_json(existing_config_name, config_tree);
-
-		// Debug print config tree.
+		readConfiguration(existing_config_name, vm.count("use-snapshot") > 0);
 		LOG(LSTATUS) << "Configuration file \"" << existing_config_name + "\" was loaded properly";
-	    print(config_tree);
-
 	}
 	catch(boost::property_tree::json_parser_error&) {
 		LOG(LERROR) << "Configuration file \"" << existing_config_name + "\" was not found or invalid";
@@ -182,6 +212,43 @@ void ParameterServer::parseApplicationParameters(int argc, char* argv[]) {
 		exit (0);
 	}//: catch
 
+	if (vm.count("watch-config"))
+		watchConfiguration();
+}
+
+
+void ParameterServer::readConfiguration(const std::string & filename_, bool use_snapshot_) {
+	// Read the whole file and parse it - the values are loaded later, when all property trees are registered.
+	std::ifstream cfg(filename_.c_str(), std::ios::in | std::ios::binary);
+	if (!cfg)
+		throw boost::property_tree::json_parser_error("cannot open file", filename_, 0);
+	config_text.assign(std::istreambuf_iterator<char>(cfg), std::istreambuf_iterator<char>());
+	config_filename = filename_;
+	config_tree.clear();
+	config_document.clear();
+	config_snapshot.close();
+
+	if (use_snapshot_) {
+		// Use the snapshot compiled from the same contents - or compile it (checking the syntax on the way).
+		std::string snapshot_name = ConfigSnapshot::snapshotName(config_filename);
+		uint64_t hash = ConfigSnapshot::hash(config_text.data(), config_text.size());
+		if (!config_snapshot.open(snapshot_name, hash) && ConfigSnapshot::compile(config_text, config_filename, snapshot_name))
+			config_snapshot.open(snapshot_name, hash);
+		if (config_snapshot.isOpen())
+			return;
+		// The snapshot cannot be written (e.g. read-only directory or full disk) - use the text of the file.
+		LOG(LWARNING) << "Configuration snapshot \"" << snapshot_name << "\" cannot be used, reading the configuration file instead";
+	}//: if
+
+	JsonConfigReader(config_text, config_filename).read(config_document);
+
+	// Debug print of the read values.
+	LOG(LDEBUG) << "Properties loaded from config file (raw):";
+	for (JsonConfigReader::Document::const_iterator node = config_document.begin(); node != config_document.end(); ++node) {
+		LOG(LDEBUG) << node->first << ":";
+		for (JsonConfigReader::NodeValues::const_iterator value = node->second.begin(); value != node->second.end(); ++value)
+			LOG(LDEBUG) << "  " << value->first << ": " << value->second;
+	}//: for
 }
 
 
@@ -194,18 +261,11 @@ void ParameterServer::registerPropertyTree(mic::configuration::PropertyTree* pt_
 }
 
 void ParameterServer::loadPropertiesFromConfiguration() {
-	// For each "main" node in the loaded configuration.
-    for (boost::property_tree::ptree::const_iterator cfg_it = config_tree.begin(); cfg_it != config_tree.end(); ++cfg_it) {
-
-    	// Find property tree with given id.
-    	id_pt_it_t reg_it = property_trees_registry.find(cfg_it->first);
-    	if (reg_it != property_trees_registry.end()) {
-    		 reg_it->second->loadPropertiesFromConfigNode(cfg_it->second);
-    	} else {
-    		LOG(LERROR) <<"Object \"" << cfg_it->first << "\" appearing in the loaded config file was not found in the property tree registry";
-    	}//: else
-
-    }//: for
+	// For each "main" node in the loaded configuration - find property tree with given id and load its properties.
+	if (config_snapshot.isOpen())
+		config_snapshot.load(property_trees_registry);
+	else
+		JsonConfigReader::load(config_document, property_trees_registry);
 
     LOG(LINFO) << "Configuration completed";
 	LOG(LSTATUS) << "List of application properties:";
@@ -233,6 +293,98 @@ void ParameterServer::initializePropertyDependentVariables() {
 }
 
 
+bool ParameterServer::watchConfiguration() {
+	if (watch_fd >= 0)
+		return true;
+	if (config_filename.empty()) {
+		LOG(LWARNING) << "No configuration file loaded - nothing to watch";
+		return false;
+	}//: if
+#ifdef __linux__
+	size_t slash = config_filename.find_last_of('/');
+	std::string dir = (slash == std::string::npos) ? "." : config_filename.substr(0, slash + 1);
+	watch_name = (slash == std::string::npos) ? config_filename : config_filename.substr(slash + 1);
+
+	watch_fd = inotify_init1(IN_NONBLOCK | IN_CLOEXEC);
+	if (watch_fd < 0) {
+		LOG(LERROR) << "Cannot watch the configuration file \"" << config_filename << "\": " << std::strerror(errno);
+		return false;
+	}//: if
+	if (inotify_add_watch(watch_fd, dir.c_str(), IN_CLOSE_WRITE | IN_MOVED_TO) < 0) {
+		LOG(LERROR) << "Cannot watch the configuration file \"" << config_filename << "\": " << std::strerror(errno);
+		::close(watch_fd);
+		watch_fd = -1;
+		return false;
+	}//: if
+	LOG(LSTATUS) << "Watching the configuration file \"" << config_filename << "\"";
+	return true;
+#else
+	LOG(LWARNING) << "Watching the configuration file is not supported on this platform";
+	return false;
+#endif
+}
+
+
+bool ParameterServer::applyConfigurationChanges() {
+	if (watch_fd < 0)
+		return false;
+#ifdef __linux__
+	// Drain the events - several events (e.g. a few writes by the editor) result in a single reload.
+	bool changed = false;
+	char buf[4096] __attribute__ ((aligned(__alignof__(struct inotify_event))));
+	for (;;) {
+		ssize_t len = ::read(watch_fd, buf, sizeof(buf));
+		if (len <= 0)
+			break;
+		for (char * ptr = buf; ptr < buf + len; ptr += sizeof(struct inotify_event) + ((struct inotify_event *)ptr)->len) {
+			const struct inotify_event * event = (const struct inotify_event *)ptr;
+			if ((event->len > 0) && (watch_name == event->name))
+				changed = true;
+		}//: for
+	}//: for
+	if (!changed)
+		return false;
+	return reloadConfiguration();
+#else
+	return false;
+#endif
+}
+
+
+bool ParameterServer::reloadConfiguration() {
+	std::ifstream cfg(config_filename.c_str(), std::ios::in | std::ios::binary);
+	if (!cfg) {
+		LOG(LERROR) << "Cannot reload the configuration file \"" << config_filename << "\"";
+		return false;
+	}//: if
+	std::string text((std::istreambuf_iterator<char>(cfg)), std::istreambuf_iterator<char>());
+
+	// Parse the whole file first - so a half-written file does not change anything.
+	JsonConfigReader::Document document;
+	try {
+		JsonConfigReader(text, config_filename).read(document);
+	}
+	catch(boost::property_tree::json_parser_error & e) {
+		LOG(LERROR) << "Configuration file \"" << config_filename << "\" is invalid, keeping the current configuration: " << e.what();
+		return false;
+	}//: catch
+	JsonConfigReader::ChangedProperties changed;
+	JsonConfigReader::reload(document, property_trees_registry, changed);
+	config_text.swap(text);
+	config_document.swap(document);
+	config_tree.clear();
+
+	// Update the variables depending on the changed properties only.
+	for (JsonConfigReader::ChangedProperties::iterator it = changed.begin(); it != changed.end(); ++it) {
+		LOG(LINFO) << "Updating property-dependent variables of \"" << it->first->getNodeName() << "\"";
+		it->first->updatePropertyDependentVariables(it->second);
+	}//: for
+
+	LOG(LSTATUS) << "Configuration file \"" << config_filename << "\" was reloaded, " << changed.size() << " object(s) changed";
+	return true;
+}
+
+
 boost::program_options::options_description &ParameterServer::getProgramOptions() {
 	return program_options;
 }
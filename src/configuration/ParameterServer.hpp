@@ -31,6 +31,9 @@
 using namespace mic::logger;
 
 #include <configuration/PropertyTree.hpp>
+#include <configuration/LoggerConfiguration.hpp>
+#include <configuration/ConfigSnapshot.hpp>
+#include <configuration/JsonConfigReader.hpp>
 
 
 namespace mic {
@@ -71,6 +74,7 @@ public:
 
 	/*!
 	 * Returns property tree of a node of given name. Returns nullptr if not found.
+	 * The tree of the configuration file is built on first use (properties are loaded without it, see JsonConfigReader).
 	 * @param node_name_ Name of the node.
 	 * @return Property tree of a found node, nullptr otherwise.
 	 */
@@ -101,8 +105,19 @@ public:
 	 */
 	void parseApplicationParameters(int argc, char* argv[]);
 
+	/*!
+	 * Reads the configuration file - its values are loaded by loadPropertiesFromConfiguration().
+	 * When the binary snapshot is used, but it cannot be opened nor compiled (e.g. in a read-only directory), the text of the file is parsed instead.
+	 * Throws boost::property_tree::json_parser_error if the file cannot be read or is invalid.
+	 * @param filename_ Name of the configuration file.
+	 * @param use_snapshot_ Flag denoting whether the binary snapshot of the file should be used (see ConfigSnapshot).
+	 */
+	void readConfiguration(const std::string & filename_, bool use_snapshot_);
+
 	/*!
 	 * Loads the properties from configuration. For each main node of the loaded configuration file it tries to find the corresponding "registered property tree", and if succeed - loads its properties.
+	 * The file was already read in a single pass by parseApplicationParameters(), the gathered values are passed to the registered properties (see JsonConfigReader).
+	 * When the binary snapshot of the file is used (-b), the values are passed straight from the mapped snapshot instead (see ConfigSnapshot).
 	 */
 	void loadPropertiesFromConfiguration();
 
@@ -111,6 +126,33 @@ public:
 	 */
 	void initializePropertyDependentVariables();
 
+	/*!
+	 * Starts watching the loaded configuration file (with inotify) - its changes are applied by applyConfigurationChanges().
+	 * The directory of the file is watched, so files replaced by editors (written to a temporary file and renamed) are handled too.
+	 * @return True if the file is watched.
+	 */
+	bool watchConfiguration();
+
+	/*!
+	 * Returns true if the configuration file is watched.
+	 */
+	bool isConfigurationWatched() const { return watch_fd >= 0; }
+
+	/*!
+	 * Checks (without blocking) whether the watched configuration file has changed, and if so - reloads it.
+	 * Must be called at a safe point, i.e. between the iterations of the application.
+	 * @return True if the configuration was reloaded.
+	 */
+	bool applyConfigurationChanges();
+
+	/*!
+	 * Reads the configuration file again and applies the values that differ from the current values of properties.
+	 * Invalid files are reported and ignored - no value is changed then. For every tree with changed properties
+	 * PropertyTree::updatePropertyDependentVariables() is called.
+	 * @return True if the file was valid.
+	 */
+	bool reloadConfiguration();
+
 
 	/*!
 	 * Returns number of application parameters.
@@ -143,13 +185,28 @@ private:
 	 */
 	ParameterServer();
 
-	//virtual ~ParameterServer();
+	/*!
+	 * Destructor. Stops watching the configuration file.
+	 */
+	virtual ~ParameterServer();
 
 	/*!
-	 * Property tree.
+	 * Property tree - built from the configuration text on first use (see returnNode()).
 	 */
     boost::property_tree::ptree config_tree;
 
+	/// Contents of the configuration file.
+	std::string config_text;
+
+	/// Name of the configuration file.
+	std::string config_filename;
+
+	/// Values of the main nodes of the configuration file - read (and checked) once, loaded when all property trees are registered.
+	JsonConfigReader::Document config_document;
+
+	/// Binary snapshot of the configuration file (mapped only if used and up to date).
+	ConfigSnapshot config_snapshot;
+
     /*!
      * Program options, to parse command line arguments.
      * This gets populated by default with a few arguments (like "help") and applications
@@ -182,6 +239,15 @@ private:
 	 /// Name of the executed binary file.
 	 std::string application_name;
 
+	 /// Properties of the logger (created when parsing the application parameters).
+	 LoggerConfiguration * logger_configuration;
+
+	 /// Inotify descriptor watching the directory of the configuration file (-1 - not watched).
+	 int watch_fd;
+
+	 /// Name of the configuration file (without the directory) - checked in the inotify events.
+	 std::string watch_name;
+
 };
 
 
@@ -25,6 +25,8 @@
 
 #include <string>
 
+#include <configuration/PropertyTranslators.hpp>
+
 #include <boost/lexical_cast.hpp>
 #include <boost/function.hpp>
 
@@ -32,6 +34,7 @@
 #include <boost/preprocessor/tuple/to_list.hpp>
 
 #include <typeinfo>
+#include <type_traits>
 #include <map>
 #include <sstream>
 
@@ -80,9 +83,66 @@ public:
 		}
 		return T();
 	}
+
+	static T fromChars(const char * str, size_t len) {
+		try {
+			return boost::lexical_cast<T>(str, len);
+		} catch (...) {
+			return fromStr(std::string(str, len));
+		}
+	}
+};
+
+
+/*!
+ * \brief Selects the translator used by properties of a given type by default - the typed translators for arithmetic types
+ * (except characters), LexicalTranslator for the other types.
+ * \author tkornuta
+ */
+template<typename T>
+struct DefaultTranslator {
+	typedef typename std::conditional<std::is_same<T, bool>::value, BoolTranslator,
+		typename std::conditional<std::is_same<T, char>::value || std::is_same<T, signed char>::value || std::is_same<T, unsigned char>::value, LexicalTranslator<T>,
+		typename std::conditional<std::is_integral<T>::value, IntegralTranslator<T>,
+		typename std::conditional<std::is_floating_point<T>::value, FloatingTranslator<T>,
+		LexicalTranslator<T> >::type>::type>::type>::type type;
 };
 
 
+/*!
+ * Translates the characters with Translator::fromChars() - used when the translator provides it.
+ */
+template<typename T, typename Translator>
+auto translateChars(const char * str_, size_t len_, int) -> decltype(Translator::fromChars(str_, len_)) {
+	return Translator::fromChars(str_, len_);
+}
+
+/*!
+ * Translates the characters with Translator::fromStr() - used by translators that have no fromChars().
+ */
+template<typename T, typename Translator>
+T translateChars(const char * str_, size_t len_, long) {
+	return Translator::fromStr(std::string(str_, len_));
+}
+
+/*!
+ * Formats the value into the buffer with Translator::toChars() - used when the translator provides it.
+ */
+template<typename T, typename Translator>
+auto formatChars(const T & val_, char * buf_, size_t size_, int) -> decltype(Translator::toChars(val_, buf_, size_)) {
+	return Translator::toChars(val_, buf_, size_);
+}
+
+/*!
+ * Formats the value with Translator::toStr() and copies it into the buffer - used by translators that have no toChars().
+ */
+template<typename T, typename Translator>
+size_t formatChars(const T & val_, char * buf_, size_t size_, long) {
+	std::string str = Translator::toStr(val_);
+	return copyChars(str.data(), str.size(), buf_, size_);
+}
+
+
 /*!
  * \brief Basic interface property - used during registration etc.
  * \author tkornuta
@@ -110,6 +170,26 @@ public:
 	 */
 	virtual void setValue(const std::string & str) = 0;
 
+	/*!
+	 * Retrieves the value of property from characters (not necessarily zero-terminated) - used by the configuration reader.
+	 * By default the characters are copied into a string passed to setValue(), concrete properties parse them directly.
+	 * @param str_ Characters from which value will be retrieved.
+	 * @param len_ Number of characters.
+	 */
+	virtual void setValue(const char * str_, size_t len_) {
+		setValue(std::string(str_, len_));
+	}
+
+	/*!
+	 * Returns the canonical form of the value given by characters (as getValue() would return it after setValue()), without setting it -
+	 * used for detecting changes of the reloaded configuration. By default returns the characters as they are, concrete properties parse them.
+	 * @param str_ Characters from which value will be retrieved.
+	 * @param len_ Number of characters.
+	 */
+	virtual std::string canonicalValue(const char * str_, size_t len_) {
+		return std::string(str_, len_);
+	}
+
 	/*!
 	 * Abstract method for returning the string representing the current value.
 	 *
@@ -117,6 +197,17 @@ public:
 	 */
 	virtual std::string getValue() = 0;
 
+	/*!
+	 * Formats the current value into the buffer of the caller (without the terminating zero).
+	 * @param buf_ Buffer.
+	 * @param size_ Size of the buffer.
+	 * @return Length of the value - if greater than size_, the value was truncated.
+	 */
+	virtual size_t getValue(char * buf_, size_t size_) {
+		std::string str = getValue();
+		return copyChars(str.data(), str.size(), buf_, size_);
+	}
+
 private:
 	/// Name of the property.
 	std::string property_name;
@@ -127,9 +218,11 @@ private:
 
 /*!
  * \brief Template class for storing properties.
+ * Values are converted from/to text by the Translator - by default the typed one for arithmetic types (see DefaultTranslator).
+ * Translators report invalid values by throwing std::invalid_argument or std::out_of_range (the value is not changed then).
  * \author tkornuta
  */
-template<class T, class Translator = LexicalTranslator<T> >
+template<class T, class Translator = typename DefaultTranslator<T>::type >
 class Property : public PropertyInterface {
 public:
 	/*!
@@ -173,7 +266,7 @@ public:
 	 * @param value_ New value to be set.
 	 * @return Current value
 	 */
-	Property<T>& operator=(T const & value_) {
+	Property& operator=(T const & value_) {
 		property_value = value_;
 		return *this;
 	}
@@ -205,6 +298,24 @@ public:
 		property_value = Translator::fromStr(str);
 	}
 
+	/*!
+	 * Sets value on a basis of characters (with the use of translator, without copying them into a string when possible).
+	 * @param str_ Characters to retrieve value from.
+	 * @param len_ Number of characters.
+	 */
+	virtual void setValue(const char * str_, size_t len_) {
+		property_value = translateChars<T, Translator>(str_, len_, 0);
+	}
+
+	/*!
+	 * Returns the canonical form of the value given by characters (with the use of translator), without setting it.
+	 * @param str_ Characters from which value will be retrieved.
+	 * @param len_ Number of characters.
+	 */
+	virtual std::string canonicalValue(const char * str_, size_t len_) {
+		return Translator::toStr(translateChars<T, Translator>(str_, len_, 0));
+	}
+
 	/*!
 	 * Returns the string representing the current value.
 	 *
@@ -214,6 +325,16 @@ public:
 		return Translator::toStr(property_value);
 	}
 
+	/*!
+	 * Formats the current value into the buffer of the caller (with the use of translator).
+	 * @param buf_ Buffer.
+	 * @param size_ Size of the buffer.
+	 * @return Length of the value - if greater than size_, the value was truncated.
+	 */
+	virtual size_t getValue(char * buf_, size_t size_) {
+		return formatChars<T, Translator>(property_value, buf_, size_, 0);
+	}
+
 	/*!
 	 * Returns property type.
 	 * @return Type.
@@ -22,10 +22,31 @@
 #include <gtest/gtest.h>
 
 #include <fstream>
+#include <clocale>
+#include <cstdio>
+#include <cstdlib>
+#include <limits>
+#include <stdexcept>
+
+#include <dirent.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#include <configuration/JsonConfigReader.hpp>
+#include <configuration/ConfigSnapshot.hpp>
+#include <configuration/AtomicProperty.hpp>
+#include <logger/LogCategory.hpp>
+#include <logger/LogSite.hpp>
+#include <boost/thread/thread.hpp>
+#include <boost/property_tree/json_parser.hpp>
+#include <boost/program_options.hpp>
+#include <logger/Log.hpp>
 
 // Redefine word "public" so every class field/method will be accessible for tests.
 #define private public
 #include <configuration/Property.hpp>
+#include <configuration/LoggerConfiguration.hpp>
+#include <configuration/ParameterServer.hpp>
 
 /*!
  * Tests whether assign operator works properly - for strings.
@@ -73,6 +94,493 @@ TEST(Property, OperatorAssignDouble) {
 }
 
 
+/*!
+ * Tests the typed translators of arithmetic properties - parsing, range checks and reporting of invalid values.
+ */
+TEST(Property, TypedTranslators) {
+	mic::configuration::Property<int> i("int_property", 7);
+	i.setValue(" -42 ");
+	EXPECT_EQ(i, -42);
+	EXPECT_THROW(i.setValue("12x"), std::invalid_argument);
+	EXPECT_THROW(i.setValue(""), std::invalid_argument);
+	EXPECT_THROW(i.setValue("2147483648"), std::out_of_range);
+	EXPECT_EQ(i, -42);
+	i.setValue("-2147483648");
+	EXPECT_EQ(i, std::numeric_limits<int>::min());
+
+	mic::configuration::Property<long long> ll("long_property", 0);
+	ll.setValue("-9223372036854775808");
+	EXPECT_EQ(ll, std::numeric_limits<long long>::min());
+	EXPECT_THROW(ll.setValue("9223372036854775808"), std::out_of_range);
+
+	mic::configuration::Property<unsigned int> u("unsigned_property", 0);
+	u.setValue("4294967295");
+	EXPECT_EQ(u, 4294967295u);
+	EXPECT_THROW(u.setValue("-1"), std::invalid_argument);
+
+	mic::configuration::Property<double> d("double_property", 0);
+	d.setValue("2.5e-3");
+	EXPECT_EQ(d, 2.5e-3);
+	EXPECT_THROW(d.setValue("1,5"), std::invalid_argument);
+	EXPECT_THROW(d.setValue("1e400"), std::out_of_range);
+	mic::configuration::Property<float> f("float_property", 0);
+	EXPECT_THROW(f.setValue("1e39"), std::out_of_range);
+
+	mic::configuration::Property<bool> b("bool_property", false);
+	b.setValue("TRUE");
+	EXPECT_TRUE((bool)b);
+	b.setValue("0");
+	EXPECT_FALSE((bool)b);
+	EXPECT_THROW(b.setValue("2"), std::invalid_argument);
+	EXPECT_EQ(b.getValue(), "false");
+
+	// Formatting into the buffer of the caller.
+	char buf[8];
+	d = 0.1;
+	ASSERT_EQ(d.getValue(buf, sizeof(buf)), 3u);
+	EXPECT_EQ(std::string(buf, 3), "0.1");
+	i = -1234567890;
+	EXPECT_EQ(i.getValue(buf, sizeof(buf)), 11u);
+	EXPECT_EQ(std::string(buf, sizeof(buf)), "-1234567");
+	mic::configuration::Property<std::string> s("string_property", "abc");
+	ASSERT_EQ(s.getValue(buf, sizeof(buf)), 3u);
+	EXPECT_EQ(std::string(buf, 3), "abc");
+}
+
+
+/*!
+ * Tests whether floating point values are formatted and parsed with the decimal point when the program uses a comma-decimal locale.
+ */
+TEST(Property, FloatingTranslatorIgnoresLocale) {
+	const std::string previous = std::setlocale(LC_NUMERIC, NULL);
+	const char * locales[] = { "de_DE.UTF-8", "de_DE.utf8", "de_DE", "fr_FR.UTF-8", "fr_FR.utf8", "pl_PL.UTF-8" };
+	bool found = false;
+	for (size_t i = 0; (i < sizeof(locales) / sizeof(locales[0])) && !found; i++)
+		found = (std::setlocale(LC_NUMERIC, locales[i]) != NULL);
+	if (!found)
+		GTEST_SKIP() << "No comma-decimal locale available";
+
+	char printed[16];
+	std::snprintf(printed, sizeof(printed), "%g", 0.5);
+	mic::configuration::Property<double> d("double_property", 0);
+	d = 0.25;
+	std::string formatted = d.getValue();
+	d.setValue("1.5");
+	double parsed = d;
+	char fixed[mic::logger::number_length];
+	std::string fixed_formatted(fixed, mic::logger::formatFixed(0.5, 12, fixed));
+	std::setlocale(LC_NUMERIC, previous.c_str());
+
+	EXPECT_EQ(std::string(printed), "0,5");
+	EXPECT_EQ(formatted, "0.25");
+	EXPECT_EQ(parsed, 1.5);
+	EXPECT_EQ(fixed_formatted, "0.500000000000");
+}
+
+
+/*!
+ * Tests whether the atomic property converts and versions its value.
+ */
+TEST(AtomicProperty, ValueAndVersion) {
+	mic::configuration::AtomicProperty<double> prop("double_property", 1000);
+	EXPECT_EQ((double)prop, 1000.0);
+	EXPECT_EQ(prop.version(), 0u);
+	prop = 2.5;
+	EXPECT_EQ(prop(), 2.5);
+	prop.setValue("0.125");
+	EXPECT_EQ(prop.load(), 0.125);
+	EXPECT_EQ(prop.getValue(), "0.125");
+	EXPECT_EQ(prop.version(), 2u);
+	EXPECT_THROW(prop.setValue("fast"), std::invalid_argument);
+	EXPECT_EQ(prop.version(), 2u);
+}
+
+
+/*!
+ * Multi-word value used by the concurrent test - all fields are always equal.
+ */
+struct Triple {
+	double a, b, c;
+};
+
+std::ostream & operator<<(std::ostream & os_, const Triple & t_) {
+	return os_ << t_.a << " " << t_.b << " " << t_.c;
+}
+
+std::istream & operator>>(std::istream & is_, Triple & t_) {
+	return is_ >> t_.a >> t_.b >> t_.c;
+}
+
+
+/*!
+ * Tests whether readers never see a torn multi-word value while it is being changed by another thread.
+ */
+TEST(AtomicProperty, NoTornReads) {
+	Triple zero = { 0, 0, 0 };
+	mic::configuration::AtomicProperty<Triple> prop("triple_property", zero);
+
+	struct Writer {
+		mic::configuration::AtomicProperty<Triple> & prop;
+		void operator()() {
+			for (int i = 1; i <= 100000; i++) {
+				Triple t = { (double)i, (double)i, (double)i };
+				prop = t;
+			}//: for
+		}
+	};
+	Writer w = { prop };
+	boost::thread writer(w);
+	size_t torn = 0;
+	uint64_t last_version = 0;
+	while (prop.version() < 100000) {
+		Triple t = prop.load();
+		if ((t.a != t.b) || (t.b != t.c))
+			torn++;
+		EXPECT_GE(prop.version(), last_version);
+		last_version = prop.version();
+	}//: while
+	writer.join();
+	EXPECT_EQ(torn, 0u);
+	EXPECT_EQ(prop.load().c, 100000.0);
+}
+
+
+/*!
+ * Property tree used by the configuration reader tests.
+ */
+class TestNode : public mic::configuration::PropertyTree {
+public:
+	TestNode() : PropertyTree("test_node"), i("i", 0), d("d", 0), s("s", ""), raw("raw", "") {
+		registerProperty(i);
+		registerProperty(d);
+		registerProperty(s);
+		registerProperty(raw);
+	}
+
+	void initializePropertyDependentVariables() { }
+
+	void updatePropertyDependentVariables(const std::vector<std::string> & changed_properties_) {
+		updated.insert(updated.end(), changed_properties_.begin(), changed_properties_.end());
+	}
+
+	/// Names of the properties passed to updatePropertyDependentVariables().
+	std::vector<std::string> updated;
+
+	mic::configuration::Property<int> i;
+	mic::configuration::Property<double> d;
+	mic::configuration::Property<std::string> s;
+	mic::configuration::Property<std::string> raw;
+};
+
+
+/*!
+ * Tests whether the streaming reader loads values of the registered properties and skips the unknown nodes.
+ */
+TEST(JsonConfigReader, LoadsRegisteredProperties) {
+	TestNode node;
+	std::map<std::string, mic::configuration::PropertyTree*> registry;
+	registry["test_node"] = &node;
+
+	std::string text = "{\n"
+		"  \"unknown_node\": { \"x\": [1, {\"y\": \"}\"}], \"z\": null },\n"
+		"  \"test_node\": { \"i\": \"42\", \"d\": -2.5e1, \"s\": \"a\\\"b\\u0041\\u00e9\", \"nested\": {\"q\": 1},\n"
+		"    \"raw\": true, \"unknown\": 7 }\n"
+		"}\n";
+	mic::configuration::JsonConfigReader(text, "test.json").load(registry);
+
+	EXPECT_EQ((int)node.i, 42);
+	EXPECT_EQ((double)node.d, -25.0);
+	EXPECT_EQ((std::string)node.s, "a\"bA\xc3\xa9");
+	EXPECT_EQ((std::string)node.raw, "true");
+
+	// Invalid values are reported and do not change the property.
+	EXPECT_FALSE(node.loadPropertyValue("i", "4x", 2));
+	EXPECT_EQ((int)node.i, 42);
+
+	// Values are passed to properties only when the whole document is valid.
+	std::string truncated = "{ \"test_node\": { \"i\": 7, \"d\": 1.0 ";
+	EXPECT_THROW(mic::configuration::JsonConfigReader(truncated, "test.json").load(registry), boost::property_tree::json_parser_error);
+	EXPECT_EQ((int)node.i, 42);
+}
+
+
+/*!
+ * Tests whether syntax errors are reported with the line number.
+ */
+TEST(JsonConfigReader, ReportsSyntaxErrors) {
+	const char * invalid[] = { "", "{", "{\"a\": {\"b\": 1,}}", "{\"a\": {\"b\": 01}}", "{\"a\": tru}", "{\"a\": \"x}", "{} {}", "{\"a\": \"\\q\"}" };
+	for (size_t k = 0; k < sizeof(invalid) / sizeof(invalid[0]); k++) {
+		std::string text = invalid[k];
+		EXPECT_THROW(mic::configuration::JsonConfigReader(text, "test.json").validate(), boost::property_tree::json_parser_error) << text;
+	}//: for
+
+	std::string text = "{\n\"a\": {\n\"b\" 1}}";
+	try {
+		mic::configuration::JsonConfigReader(text, "test.json").validate();
+		FAIL();
+	} catch (const boost::property_tree::json_parser_error & e) {
+		EXPECT_EQ(e.line(), 3u);
+		EXPECT_EQ(e.filename(), "test.json");
+	}//: catch
+}
+
+
+/*!
+ * Tests whether the reloaded configuration changes only the properties whose values differ.
+ */
+TEST(JsonConfigReader, ReloadsChangedPropertiesOnly) {
+	TestNode node;
+	std::map<std::string, mic::configuration::PropertyTree*> registry;
+	registry["test_node"] = &node;
+
+	std::string text = "{ \"test_node\": { \"i\": 1000, \"d\": 0.5, \"s\": \"abc\" } }";
+	mic::configuration::JsonConfigReader(text, "test.json").load(registry);
+
+	// Same values (in other notation) - nothing changes.
+	mic::configuration::JsonConfigReader::ChangedProperties changed;
+	std::string same = "{ \"test_node\": { \"i\": \"1000\", \"d\": 5e-1, \"s\": \"abc\" } }";
+	mic::configuration::JsonConfigReader(same, "test.json").reload(registry, changed);
+	EXPECT_TRUE(changed.empty());
+
+	// Single changed value (and an invalid one, which keeps the old value).
+	std::string modified = "{ \"test_node\": { \"i\": \"x\", \"d\": 0.25, \"s\": \"abc\" } }";
+	mic::configuration::JsonConfigReader(modified, "test.json").reload(registry, changed);
+	ASSERT_EQ(changed.size(), 1u);
+	ASSERT_EQ(changed[&node].size(), 1u);
+	EXPECT_EQ(changed[&node][0], "d");
+	EXPECT_EQ((int)node.i, 1000);
+	EXPECT_EQ((double)node.d, 0.25);
+
+	// Callback of the tree receives the changed properties.
+	for (mic::configuration::JsonConfigReader::ChangedProperties::iterator it = changed.begin(); it != changed.end(); ++it)
+		it->first->updatePropertyDependentVariables(it->second);
+	ASSERT_EQ(node.updated.size(), 1u);
+	EXPECT_EQ(node.updated[0], "d");
+}
+
+
+/*!
+ * Tests whether the reload does not write (and version) atomic properties whose values did not change.
+ */
+TEST(PropertyTree, UpdateKeepsVersionOfUnchangedValue) {
+	class AtomicNode : public mic::configuration::PropertyTree {
+	public:
+		AtomicNode() : PropertyTree("atomic_node"), rate("rate", 0.5) {
+			registerProperty(rate);
+		}
+
+		void initializePropertyDependentVariables() { }
+
+		mic::configuration::AtomicProperty<double> rate;
+	} node;
+
+	EXPECT_FALSE(node.updatePropertyValue("rate", "5e-1", 4));
+	EXPECT_EQ(node.rate.version(), 0u);
+	EXPECT_FALSE(node.updatePropertyValue("rate", "slow", 4));
+	EXPECT_EQ(node.rate.version(), 0u);
+	EXPECT_TRUE(node.updatePropertyValue("rate", "0.25", 4));
+	EXPECT_EQ(node.rate.version(), 1u);
+	EXPECT_EQ(node.rate.load(), 0.25);
+}
+
+
+/*!
+ * Tests whether the compiled snapshot loads the same values as the JSON file and whether outdated or corrupted snapshots are rejected.
+ */
+TEST(ConfigSnapshot, CompileAndLoad) {
+	TestNode node;
+	std::map<std::string, mic::configuration::PropertyTree*> registry;
+	registry["test_node"] = &node;
+
+	std::string text = "{\n"
+		"  \"unknown_node\": { \"x\": 1 },\n"
+		"  \"test_node\": { \"i\": \"42\", \"d\": -2.5e1, \"s\": \"a\\\"b\\u0041\", \"raw\": \"42\" }\n"
+		"}\n";
+	const std::string filename = "unit_tests_property.json.snapshot";
+	uint64_t hash = mic::configuration::ConfigSnapshot::hash(text.data(), text.size());
+	ASSERT_TRUE(mic::configuration::ConfigSnapshot::compile(text, "test.json", filename));
+
+	mic::configuration::ConfigSnapshot snapshot;
+	ASSERT_TRUE(snapshot.open(filename, hash));
+	snapshot.load(registry);
+	EXPECT_EQ((int)node.i, 42);
+	EXPECT_EQ((double)node.d, -25.0);
+	EXPECT_EQ((std::string)node.s, "a\"bA");
+	EXPECT_EQ((std::string)node.raw, "42");
+
+	// Snapshot of other contents.
+	EXPECT_FALSE(snapshot.open(filename, hash + 1));
+	EXPECT_FALSE(snapshot.isOpen());
+
+	// Truncated snapshot.
+	{
+		std::ifstream in(filename.c_str(), std::ios::binary);
+		std::string image((std::istreambuf_iterator<char>(in)), std::istreambuf_iterator<char>());
+		std::ofstream out(filename.c_str(), std::ios::binary | std::ios::trunc);
+		out.write(image.data(), image.size() - 1);
+	}
+	EXPECT_FALSE(snapshot.open(filename, hash));
+	std::remove(filename.c_str());
+}
+
+
+/*!
+ * Temporary directory for the files written by a test - removed together with all its files at the end of the test.
+ */
+class TempDir {
+public:
+	TempDir() {
+		const char * tmp = std::getenv("TMPDIR");
+		std::string pattern = std::string((tmp && *tmp) ? tmp : "/tmp") + "/unit_tests_property-XXXXXX";
+		std::vector<char> buf(pattern.begin(), pattern.end());
+		buf.push_back('\0');
+		if (mkdtemp(&buf[0]) == NULL)
+			throw std::runtime_error("Cannot create temporary directory " + pattern);
+		dir = &buf[0];
+	}
+
+	~TempDir() {
+		DIR * d = opendir(dir.c_str());
+		if (d) {
+			struct dirent * entry;
+			while ((entry = readdir(d)) != NULL) {
+				std::string name = entry->d_name;
+				if ((name != ".") && (name != "..") && (::unlink(path(name).c_str()) != 0))
+					::rmdir(path(name).c_str());
+			}//: while
+			closedir(d);
+		}//: if
+		::rmdir(dir.c_str());
+	}
+
+	/*!
+	 * Returns the path of the file in the directory.
+	 */
+	std::string path(const std::string & name_) const {
+		return dir + "/" + name_;
+	}
+
+private:
+	/// Path of the directory.
+	std::string dir;
+};
+
+
+/*!
+ * Writes the file (replacing its contents).
+ */
+void writeFile(const std::string & name_, const std::string & text_) {
+	std::ofstream out(name_.c_str(), std::ios::binary | std::ios::trunc);
+	out << text_;
+}
+
+
+/*!
+ * Tests whether the changes of the watched configuration file - rewritten in place or replaced by rename - are applied once,
+ * and whether invalid files are rejected without changing any property.
+ */
+TEST(ParameterServer, AppliesChangesOfWatchedFile) {
+	TempDir tmp;
+	const std::string filename = tmp.path("config.json");
+	writeFile(filename, "{ \"test_node\": { \"i\": 1, \"s\": \"first\" } }");
+
+	mic::configuration::ParameterServer server;
+	TestNode node;
+	server.registerPropertyTree(&node);
+	server.config_filename = filename;
+	ASSERT_TRUE(server.watchConfiguration());
+	EXPECT_TRUE(server.isConfigurationWatched());
+	EXPECT_FALSE(server.applyConfigurationChanges());
+
+	// Several writes in place (IN_CLOSE_WRITE) are drained and result in a single reload.
+	writeFile(filename, "{ \"test_node\": { \"i\": 2, \"s\": \"first\" } }");
+	writeFile(filename, "{ \"test_node\": { \"i\": 3, \"s\": \"first\" } }");
+	EXPECT_TRUE(server.applyConfigurationChanges());
+	EXPECT_EQ((int)node.i, 3);
+	EXPECT_EQ((std::string)node.s, "first");
+	EXPECT_FALSE(server.applyConfigurationChanges());
+
+	// File replaced by rename (IN_MOVED_TO) - as done by editors. Only the changed property is reported.
+	node.updated.clear();
+	writeFile(tmp.path("config.json.new"), "{ \"test_node\": { \"i\": 3, \"s\": \"second\" } }");
+	ASSERT_EQ(std::rename(tmp.path("config.json.new").c_str(), filename.c_str()), 0);
+	EXPECT_TRUE(server.applyConfigurationChanges());
+	EXPECT_EQ((int)node.i, 3);
+	EXPECT_EQ((std::string)node.s, "second");
+	ASSERT_EQ(node.updated.size(), 1u);
+	EXPECT_EQ(node.updated[0], "s");
+	EXPECT_FALSE(server.applyConfigurationChanges());
+
+	// Other files in the directory are ignored.
+	writeFile(tmp.path("other.json"), "{ \"test_node\": { \"i\": 5 } }");
+	EXPECT_FALSE(server.applyConfigurationChanges());
+	EXPECT_EQ((int)node.i, 3);
+
+	// Invalid (e.g. half-written) file changes nothing.
+	const std::string valid_text = server.config_text;
+	writeFile(filename, "{ \"test_node\": { \"i\": 9, \"s\": \"third\" ");
+	EXPECT_FALSE(server.applyConfigurationChanges());
+	EXPECT_EQ((int)node.i, 3);
+	EXPECT_EQ((std::string)node.s, "second");
+	EXPECT_EQ(server.config_text, valid_text);
+}
+
+
+/*!
+ * Tests whether the configuration is read from the file when its snapshot cannot be written.
+ */
+TEST(ParameterServer, ReadsFileWhenSnapshotCannotBeWritten) {
+	TempDir tmp;
+	const std::string filename = tmp.path("config.json");
+	writeFile(filename, "{ \"test_node\": { \"i\": 4, \"s\": \"text\" } }");
+	// Directory in place of the snapshot - it can be neither mapped nor replaced (unlike permissions, this also stops root).
+	ASSERT_EQ(::mkdir(mic::configuration::ConfigSnapshot::snapshotName(filename).c_str(), 0700), 0);
+
+	mic::configuration::ParameterServer server;
+	TestNode node;
+	server.registerPropertyTree(&node);
+	server.readConfiguration(filename, true);
+	EXPECT_FALSE(server.config_snapshot.isOpen());
+	server.loadPropertiesFromConfiguration();
+	EXPECT_EQ((int)node.i, 4);
+	EXPECT_EQ((std::string)node.s, "text");
+
+	// Writable directory - the snapshot is compiled and used.
+	TempDir writable;
+	const std::string other = writable.path("config.json");
+	writeFile(other, "{ \"test_node\": { \"i\": 5 } }");
+	server.readConfiguration(other, true);
+	EXPECT_TRUE(server.config_snapshot.isOpen());
+	server.loadPropertiesFromConfiguration();
+	EXPECT_EQ((int)node.i, 5);
+	server.config_snapshot.close();
+}
+
+
+/*!
+ * Tests whether the reloaded empty values of logger properties remove the applied rules and levels.
+ */
+TEST(LoggerConfiguration, AppliesEmptyValues) {
+	mic::configuration::LoggerConfiguration cfg;
+	std::string rules = "PropertyTests.cpp:*";
+	std::string levels = "test.reload=ERROR";
+	cfg.loadPropertyValue("dynamic_debug", rules.data(), rules.size());
+	cfg.loadPropertyValue("categories", levels.data(), levels.size());
+	cfg.loadPropertyValue("duplicate_window", "50", 2);
+	cfg.initializePropertyDependentVariables();
+	EXPECT_EQ(mic::logger::LogSiteRegistry::getDynamicDebug(), rules);
+	EXPECT_EQ(mic::logger::LogCategory::get("test.reload").getThreshold(), (int)mic::logger::Error);
+
+	cfg.loadPropertyValue("dynamic_debug", "", 0);
+	cfg.loadPropertyValue("categories", "", 0);
+	cfg.loadPropertyValue("duplicate_window", "0", 1);
+	cfg.initializePropertyDependentVariables();
+	EXPECT_EQ(mic::logger::LogSiteRegistry::getDynamicDebug(), "");
+	EXPECT_EQ(mic::logger::LogCategory::get("test.reload").getThreshold(), mic::logger::LogCategory::no_level);
+	EXPECT_EQ(cfg.applied_duplicate_window, 0u);
+}
+
+
 int main(int argc, char **argv) {
     testing::InitGoogleTest(&argc, argv);
     return RUN_ALL_TESTS();
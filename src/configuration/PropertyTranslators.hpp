@@ -0,0 +1,231 @@
+/*!
+ * Copyright (C) tkornuta, IBM Corporation 2015-2019
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+/*!
+ * \file PropertyTranslators.hpp
+ * \brief Contains translators converting the values of properties of arithmetic types from/to text - without lexical_cast, streams or locales.
+ * \author tkornuta
+ * \date Oct 17, 2026
+ */
+
+#ifndef SRC_CONFIGURATION_PROPERTYTRANSLATORS_HPP_
+#define SRC_CONFIGURATION_PROPERTYTRANSLATORS_HPP_
+
+#include <logger/NumberFormat.hpp>
+
+#include <stdexcept>
+#include <string>
+#include <limits>
+#include <cstring>
+#include <cstdlib>
+#include <cerrno>
+#include <cmath>
+
+#include <locale.h>
+
+namespace mic {
+namespace configuration {
+
+/*!
+ * Removes the leading and trailing white spaces.
+ * @param str_ Beginning of the characters (moved forward).
+ * @param len_ Number of characters (decreased).
+ */
+inline void trimSpaces(const char *& str_, size_t & len_) {
+	while ((len_ > 0) && ((*str_ == ' ') || (*str_ == '\t') || (*str_ == '\n') || (*str_ == '\r'))) {
+		str_++;
+		len_--;
+	}//: while
+	while ((len_ > 0) && ((str_[len_ - 1] == ' ') || (str_[len_ - 1] == '\t') || (str_[len_ - 1] == '\n') || (str_[len_ - 1] == '\r')))
+		len_--;
+}
+
+/*!
+ * Throws the exception reporting the invalid value.
+ * @param str_ Characters of the value.
+ * @param len_ Number of characters.
+ * @param type_ Name of the expected type.
+ */
+inline void invalidValue(const char * str_, size_t len_, const char * type_) {
+	throw std::invalid_argument("\"" + std::string(str_, len_) + "\" is not a valid " + type_ + " value");
+}
+
+/*!
+ * Copies the formatted value into the buffer of the caller.
+ * @return Length of the value (greater than size_ if the value was truncated).
+ */
+inline size_t copyChars(const char * src_, size_t len_, char * buf_, size_t size_) {
+	std::memcpy(buf_, src_, (len_ < size_) ? len_ : size_);
+	return len_;
+}
+
+
+/*!
+ * \brief Translator of integral types - checks the syntax and the range of the value.
+ * \author tkornuta
+ */
+template<typename T>
+class IntegralTranslator {
+public:
+	static T fromChars(const char * str, size_t len) {
+		const char * p = str;
+		size_t n = len;
+		trimSpaces(p, n);
+		bool negative = false;
+		if ((n > 0) && ((*p == '+') || (*p == '-'))) {
+			negative = (*p == '-');
+			p++;
+			n--;
+		}//: if
+		if ((n == 0) || (negative && !std::numeric_limits<T>::is_signed))
+			invalidValue(str, len, "integer");
+
+		// Magnitude of the minimal value computed without overflow.
+		uint64_t limit = negative ? (uint64_t)(-(std::numeric_limits<T>::min() + 1)) + 1 : (uint64_t)std::numeric_limits<T>::max();
+		uint64_t mag = 0;
+		for (size_t i = 0; i < n; i++) {
+			unsigned d = (unsigned)(p[i] - '0');
+			if (d > 9)
+				invalidValue(str, len, "integer");
+			if (mag > (limit - d) / 10)
+				throw std::out_of_range("\"" + std::string(str, len) + "\" is out of range of the integer type");
+			mag = mag * 10 + d;
+		}//: for
+		if (!negative)
+			return (T)mag;
+		return (mag == 0) ? (T)0 : (T)(-(int64_t)(mag - 1) - 1);
+	}
+
+	static T fromStr(const std::string & str) {
+		return fromChars(str.data(), str.size());
+	}
+
+	static size_t toChars(const T & val, char * buf, size_t size) {
+		char tmp[mic::logger::number_length];
+		size_t len = std::numeric_limits<T>::is_signed ? mic::logger::formatSigned((int64_t)val, tmp) : mic::logger::formatUnsigned((uint64_t)val, tmp);
+		return copyChars(tmp, len, buf, size);
+	}
+
+	static std::string toStr(const T & val) {
+		char tmp[mic::logger::number_length];
+		return std::string(tmp, toChars(val, tmp, sizeof(tmp)));
+	}
+};
+
+
+/*!
+ * \brief Translator of floating point types - parses and formats the value in the C locale (decimal point), regardless of the locale of the program.
+ * \author tkornuta
+ */
+template<typename T>
+class FloatingTranslator {
+public:
+	static T fromChars(const char * str, size_t len) {
+		const char * p = str;
+		size_t n = len;
+		trimSpaces(p, n);
+		// Copy into zero-terminated buffer (on stack, unless the value is unusually long).
+		char tmp[64];
+		std::string long_value;
+		const char * z = tmp;
+		if (n < sizeof(tmp)) {
+			std::memcpy(tmp, p, n);
+			tmp[n] = '\0';
+		} else {
+			long_value.assign(p, n);
+			z = long_value.c_str();
+		}//: else
+		char * end = NULL;
+		errno = 0;
+		double val = (n > 0) ? strtod_l(z, &end, mic::logger::cLocale()) : 0;
+		if ((n == 0) || (end != z + n))
+			invalidValue(str, len, "floating point");
+		if (((errno == ERANGE) && std::isinf(val)) || (std::isfinite(val) && (std::fabs(val) > (double)std::numeric_limits<T>::max())))
+			throw std::out_of_range("\"" + std::string(str, len) + "\" is out of range of the floating point type");
+		return (T)val;
+	}
+
+	static T fromStr(const std::string & str) {
+		return fromChars(str.data(), str.size());
+	}
+
+	static size_t toChars(const T & val, char * buf, size_t size) {
+		char tmp[mic::logger::number_length];
+		return copyChars(tmp, mic::logger::formatDouble((double)val, tmp), buf, size);
+	}
+
+	static std::string toStr(const T & val) {
+		char tmp[mic::logger::number_length];
+		return std::string(tmp, toChars(val, tmp, sizeof(tmp)));
+	}
+};
+
+
+/*!
+ * \brief Translator of bool - accepts true/false, yes/no, on/off (case insensitive) and 1/0.
+ * \author tkornuta
+ */
+class BoolTranslator {
+public:
+	static bool fromChars(const char * str, size_t len) {
+		const char * p = str;
+		size_t n = len;
+		trimSpaces(p, n);
+		static const char * const true_values[] = { "true", "yes", "on", "1" };
+		static const char * const false_values[] = { "false", "no", "off", "0" };
+		for (size_t i = 0; i < 4; i++) {
+			if (equalsIgnoreCase(p, n, true_values[i]))
+				return true;
+			if (equalsIgnoreCase(p, n, false_values[i]))
+				return false;
+		}//: for
+		invalidValue(str, len, "bool");
+		return false;
+	}
+
+	static bool fromStr(const std::string & str) {
+		return fromChars(str.data(), str.size());
+	}
+
+	static size_t toChars(const bool & val, char * buf, size_t size) {
+		return val ? copyChars("true", 4, buf, size) : copyChars("false", 5, buf, size);
+	}
+
+	static std::string toStr(const bool & val) {
+		return val ? "true" : "false";
+	}
+
+private:
+	/*!
+	 * Compares the characters with the (lower case) word, ignoring case.
+	 */
+	static bool equalsIgnoreCase(const char * str_, size_t len_, const char * word_) {
+		if (std::strlen(word_) != len_)
+			return false;
+		for (size_t i = 0; i < len_; i++) {
+			char c = str_[i];
+			if ((c >= 'A') && (c <= 'Z'))
+				c = (char)(c - 'A' + 'a');
+			if (c != word_[i])
+				return false;
+		}//: for
+		return true;
+	}
+};
+
+} /* namespace configuration */
+} /* namespace mic */
+
+#endif /* SRC_CONFIGURATION_PROPERTYTRANSLATORS_HPP_ */
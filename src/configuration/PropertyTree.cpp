@@ -26,6 +26,9 @@
 
 #include <boost/property_tree/json_parser.hpp>
 #include <boost/foreach.hpp>
+#include <boost/utility/string_ref.hpp>
+
+#include <stdexcept>
 
 namespace mic {
 namespace configuration {
@@ -71,8 +74,14 @@ void PropertyTree::printPropertiesWithValues() {
 	}//: if
 
 	LOG(LINFO) << "Object \""<< node_name << "\":";
+	char buf[256];
 	BOOST_FOREACH(PropertyPair prop, properties) {
-		LOG(LINFO) << "\t  \"" << prop.first << "\" = " << prop.second->getValue();
+		// Format the value into the buffer (long values - as string).
+		size_t len = prop.second->getValue(buf, sizeof(buf));
+		if (len <= sizeof(buf))
+			LOG(LINFO) << "\t  \"" << prop.first << "\" = " << boost::string_ref(buf, len);
+		else
+			LOG(LINFO) << "\t  \"" << prop.first << "\" = " << prop.second->getValue();
 	}//: foreach
 }
 
@@ -88,32 +97,65 @@ PropertyInterface * PropertyTree::getProperty(const std::string& name) {
 void PropertyTree::loadPropertiesFromConfigNode(boost::property_tree::ptree const& pt_) {
 	LOG(LTRACE) << "PropertyTree::loadPropertiesFromConfigNode";
 
-	std::string name;
-	std::string value;
-	std::string key;
-
 	// Iterate through all properties in config file.
     using boost::property_tree::ptree;
     for (ptree::const_iterator it = pt_.begin(); it != pt_.end(); ++it) {
+		const std::string & value = it->second.data();
+		loadPropertyValue(it->first, value.data(), value.size());
+	}//: for
 
-		// Read name and value.
-		name = it->first;
-		value = it->second.get_value<std::string>();
+}
 
-		LOG(LDEBUG) << "Property: " << name << "=" << value;
 
-		// Find adequte object property.
-		mic::configuration::PropertyInterface * prop = getProperty(name);
-		if (!prop) {
-			LOG(LWARNING) << "Object \"" << node_name << "\" has no property named \"" << name << "\", which is defined in configuration file.";
-			continue;
-		}
+bool PropertyTree::loadPropertyValue(const std::string & name_, const char * value_, size_t len_) {
+	LOG(LDEBUG) << "Property: " << name_ << "=" << std::string(value_, len_);
+
+	// Find adequte object property.
+	std::map<std::string, mic::configuration::PropertyInterface*>::iterator it = properties.find(name_);
+	if (it == properties.end()) {
+		LOG(LWARNING) << "Object \"" << node_name << "\" has no property named \"" << name_ << "\", which is defined in configuration file.";
+		return false;
+	}//: if
+
+	// Set value - invalid values are reported, the property keeps its value.
+	try {
+		it->second->setValue(value_, len_);
+	} catch (const std::exception & e) {
+		LOG(LERROR) << "Object \"" << node_name << "\": invalid value of property \"" << name_ << "\" (" << e.what() << "), keeping " << it->second->getValue();
+		return false;
+	}//: catch
+	LOG(LINFO) << "Object \"" << node_name << "\": property \"" << name_ << "\" value set to " << it->second->getValue();
+	return true;
+}
+
+
+bool PropertyTree::updatePropertyValue(const std::string & name_, const char * value_, size_t len_) {
+	std::map<std::string, mic::configuration::PropertyInterface*>::iterator it = properties.find(name_);
+	if (it == properties.end()) {
+		LOG(LWARNING) << "Object \"" << node_name << "\" has no property named \"" << name_ << "\", which is defined in configuration file.";
+		return false;
+	}//: if
+
+	// Compare the canonical forms of the values first - the property is set only when its value differs.
+	std::string old_value = it->second->getValue();
+	std::string new_value;
+	try {
+		new_value = it->second->canonicalValue(value_, len_);
+		if (new_value == old_value)
+			return false;
+		it->second->setValue(value_, len_);
+	} catch (const std::exception & e) {
+		LOG(LERROR) << "Object \"" << node_name << "\": invalid value of property \"" << name_ << "\" (" << e.what() << "), keeping " << old_value;
+		return false;
+	}//: catch
+	new_value = it->second->getValue();
+	LOG(LSTATUS) << "Object \"" << node_name << "\": property \"" << name_ << "\" changed from " << old_value << " to " << new_value;
+	return true;
+}
 
-		// Set value.
-		prop->setValue(value);
-		LOG(LINFO) << "Object \"" << node_name << "\": property \"" << prop->name() << "\" value set to " << prop->getValue();
-	}
 
+void PropertyTree::updatePropertyDependentVariables(const std::vector<std::string> & changed_properties_) {
+	initializePropertyDependentVariables();
 }
 
 /*
@@ -27,6 +27,8 @@
 
 #include <boost/property_tree/ptree.hpp>
 
+#include <vector>
+
 namespace mic {
 namespace configuration {
 
@@ -64,6 +66,26 @@ public:
 	 */
 	void loadPropertiesFromConfigNode(boost::property_tree::ptree const& pt_);
 
+	/*!
+	 * Sets the value of property read from the configuration - warns if there is no such property.
+	 * @param name_ Name of the property.
+	 * @param value_ Characters of the value (not necessarily zero-terminated).
+	 * @param len_ Number of characters.
+	 * @return True if the property was found and the value was valid.
+	 */
+	bool loadPropertyValue(const std::string & name_, const char * value_, size_t len_);
+
+	/*!
+	 * Sets the value of property read from the reloaded configuration - only if it differs from the current one
+	 * (the values are compared in their canonical form, see PropertyInterface::canonicalValue(), so e.g. 1e3 and 1000 are equal
+	 * and an unchanged property is not written at all).
+	 * @param name_ Name of the property.
+	 * @param value_ Characters of the value (not necessarily zero-terminated).
+	 * @param len_ Number of characters.
+	 * @return True if the value of the property has changed.
+	 */
+	bool updatePropertyValue(const std::string & name_, const char * value_, size_t len_);
+
 	/*!
 	 * Prints the list of all registered properties.
 	 */
@@ -86,6 +108,13 @@ public:
 	 */
 	virtual void initializePropertyDependentVariables() = 0;
 
+	/*!
+	 * Method called after the configuration was reloaded and some of the properties of the tree have changed (see ParameterServer::applyConfigurationChanges()).
+	 * By default re-initializes all property-dependent variables; trees can override it to re-initialize only the ones depending on the changed properties.
+	 * @param changed_properties_ Names of the changed properties.
+	 */
+	virtual void updatePropertyDependentVariables(const std::vector<std::string> & changed_properties_);
+
 private:
 	/// Map of all registered properties.
 	std::map<std::string, mic::configuration::PropertyInterface*> properties;
@@ -0,0 +1,124 @@
+/*!
+ * Copyright (C) tkornuta, IBM Corporation 2015-2019
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+/*!
+ * \file BinaryFileOutput.cpp
+ * \brief Contains definitions of methods of the binary file logger output.
+ * \author tkornuta
+ * \date Oct 17, 2026
+ */
+
+#include <logger/BinaryFileOutput.hpp>
+#include <logger/LogClock.hpp>
+
+#include <stdexcept>
+#include <algorithm>
+
+namespace mic {
+namespace logger {
+
+BinaryFileOutput::BinaryFileOutput(const std::string & filename_, Severity_t sev_, size_t buffer_size_) :
+	LoggerOutput(sev_), buffer(buffer_size_)
+{
+	out = std::fopen(filename_.c_str(), "wb");
+	if (!out)
+		throw std::runtime_error("BinaryFileOutput: cannot open file " + filename_);
+	std::setvbuf(out, &buffer[0], _IOFBF, buffer.size());
+	std::fwrite(binary::magic, 1, binary::magic_length, out);
+
+	// Clock record - so the timestamps can be converted into the wall-clock time.
+	std::string rec(1, (char)binary::ClockRecord);
+	binary::appendRaw(rec, wallClockOffset());
+	std::fwrite(rec.data(), 1, rec.size(), out);
+}
+
+
+BinaryFileOutput::~BinaryFileOutput() {
+	std::fclose(out);
+}
+
+
+void BinaryFileOutput::write(const LogRecord & rec_, const LogSite & site_) const {
+	boost::mutex::scoped_lock lock(mutex);
+	if (rec_.binary)
+		writeRecord(siteId(site_), rec_.timestamp, rec_.severity, rec_.message.data(), rec_.message.size());
+	else {
+		text_args.clear();
+		binary::appendString(text_args, rec_.message.data(), rec_.message.size());
+		writeRecord(siteId(site_), rec_.timestamp, rec_.severity, text_args.data(), text_args.size());
+	}//: else
+}
+
+
+void BinaryFileOutput::print(const std::string & msg, Severity_t sev, const std::string & file, int line) const {
+	const LogSite & site = LogSiteRegistry::intern(file, line, sev);
+	boost::mutex::scoped_lock lock(mutex);
+	text_args.clear();
+	binary::appendString(text_args, msg.data(), msg.size());
+	writeRecord(siteId(site), monotonicNs(), sev, text_args.data(), text_args.size());
+}
+
+
+void BinaryFileOutput::printBinary(const std::string & args, Severity_t sev, const std::string & file, int line) const {
+	const LogSite & site = LogSiteRegistry::intern(file, line, sev);
+	boost::mutex::scoped_lock lock(mutex);
+	writeRecord(siteId(site), monotonicNs(), sev, args.data(), args.size());
+}
+
+
+void BinaryFileOutput::flush() {
+	boost::mutex::scoped_lock lock(mutex);
+	std::fflush(out);
+}
+
+
+uint32_t BinaryFileOutput::siteId(const LogSite & site_) const {
+	if ((site_.id < written_sites.size()) && written_sites[site_.id])
+		return site_.id;
+
+	// New site - write its definition.
+	if (site_.id >= written_sites.size())
+		written_sites.resize(site_.id + 1, false);
+	written_sites[site_.id] = true;
+	std::string rec(1, (char)binary::SiteRecord);
+	binary::appendRaw(rec, site_.id);
+	binary::appendRaw(rec, (int32_t)site_.line);
+	uint16_t len = (uint16_t)std::min<size_t>(site_.file_name.size(), 0xFFFF);
+	binary::appendRaw(rec, len);
+	rec.append(site_.file_name.data(), len);
+	std::fwrite(rec.data(), 1, rec.size(), out);
+	return site_.id;
+}
+
+
+void BinaryFileOutput::writeRecord(uint32_t site, int64_t timestamp, Severity_t sev, const char * args, size_t size) const {
+	uint64_t ts = (uint64_t)timestamp;
+	uint8_t s = (uint8_t)sev;
+	uint32_t len = (uint32_t)size;
+
+	// Header: type, site, timestamp, severity, size.
+	char header[1 + sizeof(site) + sizeof(ts) + sizeof(s) + sizeof(len)];
+	char * ptr = header;
+	*ptr++ = (char)binary::MessageRecord;
+	std::memcpy(ptr, &site, sizeof(site)); ptr += sizeof(site);
+	std::memcpy(ptr, &ts, sizeof(ts)); ptr += sizeof(ts);
+	std::memcpy(ptr, &s, sizeof(s)); ptr += sizeof(s);
+	std::memcpy(ptr, &len, sizeof(len));
+	std::fwrite(header, 1, sizeof(header), out);
+	std::fwrite(args, 1, len, out);
+}
+
+} /* namespace logger */
+} /* namespace mic */
@@ -0,0 +1,123 @@
+/*!
+ * Copyright (C) tkornuta, IBM Corporation 2015-2019
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+/*!
+ * \file BinaryFileOutput.hpp
+ * \brief Contains declaration of a logger output class writing compact binary records into a file.
+ * \author tkornuta
+ * \date Oct 17, 2026
+ */
+
+#ifndef SRC_LOGGER_BINARYFILEOUTPUT_HPP_
+#define SRC_LOGGER_BINARYFILEOUTPUT_HPP_
+
+#include <logger/LoggerOutput.hpp>
+
+#include <boost/thread/mutex.hpp>
+
+#include <cstdio>
+#include <vector>
+
+namespace mic {
+namespace logger {
+
+/*!
+ * \brief Class responsible for writing logs into a binary file (format described in BinaryFormat.hpp).
+ * No text formatting happens here - the files are turned into text by the mic_logdecode tool.
+ * Messages logged with LOG are stored as a single string argument, messages logged with BLOG are stored as captured.
+ * \author tkornuta
+ */
+class BinaryFileOutput : public LoggerOutput {
+public:
+	/*!
+	 * Constructor. Opens (truncates) the file and writes the header.
+	 * @param filename_ Name of the file.
+	 * @param sev_ Default output severity level (LINFO as default).
+	 * @param buffer_size_ Size of the file buffer.
+	 */
+	BinaryFileOutput(const std::string & filename_, Severity_t sev_ = LINFO, size_t buffer_size_ = 1 << 20);
+
+	/*!
+	 * Destructor. Flushes and closes the file.
+	 */
+	virtual ~BinaryFileOutput();
+
+	/*!
+	 * Writes the record - text messages are stored as a single string argument, binary ones as captured.
+	 * @param rec_ Record.
+	 * @param site_ Call site of the record.
+	 */
+	void write(const LogRecord & rec_, const LogSite & site_) const;
+
+	/*!
+	 * Writes the text message as a record with single string argument.
+	 * @param msg Message to be printed.
+	 * @param sev Severity level.
+	 * @param file File that called the log function.
+	 * @param line Line in which log function was called.
+	 */
+	void print(const std::string & msg, Severity_t sev, const std::string & file, int line) const;
+
+	/*!
+	 * Writes the binary record.
+	 * @param args Binary arguments.
+	 * @param sev Severity level.
+	 * @param file File that called the log function.
+	 * @param line Line in which log function was called.
+	 */
+	void printBinary(const std::string & args, Severity_t sev, const std::string & file, int line) const;
+
+	/*!
+	 * Flushes the file buffer.
+	 */
+	void flush();
+
+	/*!
+	 * Does nothing - the file buffer is written when full or when the logger is flushed.
+	 */
+	void endOfBatch() { }
+
+private:
+	/*!
+	 * Returns the id of the call site - writes the site record when the site appears in the file for the first time.
+	 */
+	uint32_t siteId(const LogSite & site_) const;
+
+	/*!
+	 * Writes the message record.
+	 * @param timestamp Time at which the message was logged (see monotonicNs()).
+	 */
+	void writeRecord(uint32_t site, int64_t timestamp, Severity_t sev, const char * args, size_t size) const;
+
+	/// Mutex protecting the file and the written sites.
+	mutable boost::mutex mutex;
+
+	/// Output file.
+	std::FILE * out;
+
+	/// File buffer.
+	std::vector<char> buffer;
+
+	/// Flags denoting which call sites (indexed by site id) were already written to the file.
+	mutable std::vector<bool> written_sites;
+
+	/// Buffer used for the text messages.
+	mutable std::string text_args;
+};
+
+} /* namespace logger */
+} /* namespace mic */
+
+#endif /* SRC_LOGGER_BINARYFILEOUTPUT_HPP_ */
@@ -0,0 +1,109 @@
+/*!
+ * Copyright (C) tkornuta, IBM Corporation 2015-2019
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+/*!
+ * \file BinaryFormat.cpp
+ * \brief Contains definitions of functions related to the binary log format.
+ * \author tkornuta
+ * \date Oct 17, 2026
+ */
+
+#include <logger/BinaryFormat.hpp>
+
+#include <sstream>
+
+namespace mic {
+namespace logger {
+namespace binary {
+
+bool formatArguments(const char * data_, size_t size_, std::ostream & os_) {
+	const char * end = data_ + size_;
+	while (data_ < end) {
+		char tag = *data_++;
+		switch(tag) {
+		case SignedArg: {
+			int64_t val;
+			if (!readRaw(data_, end, val))
+				return false;
+			os_ << val;
+			break;
+		}
+		case UnsignedArg: {
+			uint64_t val;
+			if (!readRaw(data_, end, val))
+				return false;
+			os_ << val;
+			break;
+		}
+		case DoubleArg: {
+			double val;
+			if (!readRaw(data_, end, val))
+				return false;
+			os_ << val;
+			break;
+		}
+		case BoolArg: {
+			uint8_t val;
+			if (!readRaw(data_, end, val))
+				return false;
+			os_ << (bool)val;
+			break;
+		}
+		case CharArg: {
+			uint8_t val;
+			if (!readRaw(data_, end, val))
+				return false;
+			os_ << (char)val;
+			break;
+		}
+		case PointerArg: {
+			uint64_t val;
+			if (!readRaw(data_, end, val))
+				return false;
+			os_ << (const void*)(uintptr_t)val;
+			break;
+		}
+		case StringArg:
+		case EventArg:
+		case KeyArg: {
+			uint32_t len;
+			if (!readRaw(data_, end, len) || ((size_t)(end - data_) < len))
+				return false;
+			if (tag == KeyArg)
+				os_ << ' ';
+			os_.write(data_, len);
+			if (tag == KeyArg)
+				os_ << '=';
+			data_ += len;
+			break;
+		}
+		default:
+			return false;
+		}//: switch
+	}//: while
+	return true;
+}
+
+
+std::string formatArguments(const std::string & args_) {
+	std::ostringstream os;
+	if (!formatArguments(args_.data(), args_.size(), os))
+		os << " <corrupted binary arguments>";
+	return os.str();
+}
+
+} /* namespace binary */
+} /* namespace logger */
+} /* namespace mic */
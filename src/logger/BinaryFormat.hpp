@@ -0,0 +1,154 @@
+/*!
+ * Copyright (C) tkornuta, IBM Corporation 2015-2019
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+/*!
+ * \file BinaryFormat.hpp
+ * \brief Contains declarations of types and functions related to the binary (deferred formatting) log format.
+ * \author tkornuta
+ * \date Oct 17, 2026
+ */
+
+#ifndef SRC_LOGGER_BINARYFORMAT_HPP_
+#define SRC_LOGGER_BINARYFORMAT_HPP_
+
+#include <string>
+#include <ostream>
+#include <cstring>
+#include <stdint.h>
+
+namespace mic {
+namespace logger {
+
+/*!
+ * \namespace mic::logger::binary
+ * \brief Contains constants and functions defining the binary log format.
+ *
+ * A binary log file starts with the magic string, followed by records (all numbers stored in native byte order):
+ *  - clock record: 'C', int64 offset of the wall-clock time from the timestamps [ns] (written after the magic string),
+ *  - site record: 'S', uint32 site id, int32 line, uint16 file name length, file name,
+ *  - message record: 'R', uint32 site id, uint64 timestamp, uint8 severity, uint32 arguments size, arguments.
+ *
+ * Timestamps are the times at which the messages were logged (not written), read from the monotonic clock of the logger
+ * (CLOCK_MONOTONIC_COARSE on Linux, see monotonicNs()) in ns - the clock record converts them into the wall-clock time.
+ *
+ * Arguments are stored as a sequence of (uint8 tag, value) pairs, where value is an int64, uint64, double, uint8 (bool/char),
+ * uint64 (pointer) or uint32 length followed by characters (string).
+ * Structured (key-value) records (see LOG_KV) start with the event name, followed by pairs of the key and the typed value.
+ * \author tkornuta
+ */
+namespace binary {
+
+/// Magic string starting every binary log file.
+const char magic[] = "MICBLOG1";
+
+/// Length of the magic string.
+const size_t magic_length = 8;
+
+/*!
+ * \brief Types of records in binary log file.
+ */
+enum RecordType_t
+{
+	ClockRecord = 'C', ///< Offset of the wall-clock time from the timestamps.
+	SiteRecord = 'S', ///< Call site definition (id, file, line).
+	MessageRecord = 'R' ///< Message (site id, timestamp, severity, arguments).
+};
+
+/*!
+ * \brief Tags of arguments stored in binary records.
+ */
+enum ArgumentTag_t
+{
+	SignedArg = 'i', ///< Signed integer, stored as int64.
+	UnsignedArg = 'u', ///< Unsigned integer, stored as uint64.
+	DoubleArg = 'd', ///< Floating point number, stored as double.
+	BoolArg = 'b', ///< Boolean, stored as uint8.
+	CharArg = 'c', ///< Character, stored as uint8.
+	PointerArg = 'p', ///< Pointer, stored as uint64.
+	StringArg = 's', ///< String, stored as uint32 length and characters.
+	EventArg = 'e', ///< Name of the event of structured record, stored as string.
+	KeyArg = 'k' ///< Key of the field of structured record (followed by the value), stored as string.
+};
+
+/*!
+ * Appends raw bytes of a value to the buffer.
+ * @param buf_ Buffer.
+ * @param val_ Value.
+ */
+template <typename T>
+inline void appendRaw(std::string & buf_, const T & val_) {
+	buf_.append(reinterpret_cast<const char*>(&val_), sizeof(T));
+}
+
+/*!
+ * Appends a tagged string argument to the buffer.
+ * @param buf_ Buffer.
+ * @param str_ String.
+ * @param len_ String length.
+ * @param tag_ Tag of the argument (string, event name or key).
+ */
+inline void appendString(std::string & buf_, const char * str_, size_t len_, ArgumentTag_t tag_ = StringArg) {
+	buf_.push_back((char)tag_);
+	appendRaw(buf_, (uint32_t)len_);
+	buf_.append(str_, len_);
+}
+
+/*!
+ * Returns true if the arguments form a structured (key-value) record.
+ * @param data_ Arguments.
+ * @param size_ Size of arguments.
+ */
+inline bool isStructured(const char * data_, size_t size_) {
+	return (size_ > 0) && (data_[0] == (char)EventArg);
+}
+
+/*!
+ * Reads raw bytes of a value from the buffer.
+ * @param data_ Pointer to data, moved forward by the size of value.
+ * @param end_ End of data.
+ * @param val_ Read value.
+ * @return False if there is not enough data.
+ */
+template <typename T>
+inline bool readRaw(const char *& data_, const char * end_, T & val_) {
+	if ((size_t)(end_ - data_) < sizeof(T))
+		return false;
+	std::memcpy(&val_, data_, sizeof(T));
+	data_ += sizeof(T);
+	return true;
+}
+
+/*!
+ * Formats the binary arguments as text - exactly as they would be formatted by std::ostream.
+ * Structured records are formatted as "event key1=value1 key2=value2".
+ * @param data_ Arguments.
+ * @param size_ Size of arguments.
+ * @param os_ Output stream.
+ * @return False if the arguments are corrupted.
+ */
+bool formatArguments(const char * data_, size_t size_, std::ostream & os_);
+
+/*!
+ * Formats the binary arguments as text.
+ * @param args_ Arguments.
+ * @return Formatted message.
+ */
+std::string formatArguments(const std::string & args_);
+
+} /* namespace binary */
+} /* namespace logger */
+} /* namespace mic */
+
+#endif /* SRC_LOGGER_BINARYFORMAT_HPP_ */
@@ -0,0 +1,233 @@
+/*!
+ * Copyright (C) tkornuta, IBM Corporation 2015-2019
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+/*!
+ * \file BinaryScopeLogger.hpp
+ * \brief Contains definition of BinaryScopeLogger class.
+ * \author tkornuta
+ * \date Oct 17, 2026
+ */
+
+#ifndef SRC_LOGGER_BINARYSCOPELOGGER_HPP_
+#define SRC_LOGGER_BINARYSCOPELOGGER_HPP_
+
+#include <logger/Logger.hpp>
+#include <logger/BinaryFormat.hpp>
+#include <logger/LogStream.hpp>
+
+#include <type_traits>
+
+namespace mic {
+namespace logger {
+
+/*!
+ * \class BinaryScopeLogger
+ * \brief Counterpart of the ScopeLogger capturing the arguments in binary form (deferred formatting).
+ * Arithmetic types, pointers and strings are stored as raw bytes, other types are formatted with their operator<<.
+ * Stream manipulators are not supported.
+ * Arguments are captured into the record of the thread-local LogStream, so in steady state no memory is allocated.
+ */
+class BinaryScopeLogger
+{
+public:
+	/*!
+	 * Constructor.
+	 * @param p_ Parent - "main" logger object.
+	 * @param site_ Call site (file, line, function) of the logger.
+	 * @param s_ Log severity level.
+	 */
+	BinaryScopeLogger(Logger * p_, const LogSite & site_, Severity_t s_) :
+		parent(p_), site(site_), severity(s_), stream(LogStream::acquire()), args(stream->record.message)
+	{
+		args.clear();
+	}
+
+	/*!
+	 * Destructor. Passes the captured arguments to parent logger.
+	 */
+	~BinaryScopeLogger() {
+		stream->record.site = site.id;
+		stream->record.severity = severity;
+		stream->record.binary = true;
+		stream->record.timestamp = monotonicNs();
+		stream->record.thread = threadId();
+		parent->log(stream->record);
+		LogStream::release(stream);
+	}
+
+	/*!
+	 * Returns the object to which user can write.
+	 */
+	BinaryScopeLogger& get() {
+		return *this;
+	}
+
+	/*!
+	 * Captures the argument.
+	 * @param val_ Value.
+	 */
+	template <typename T>
+	BinaryScopeLogger& operator<<(const T & val_) {
+		capture(val_, typename ArgumentKind<T>::type());
+		return *this;
+	}
+
+	/*!
+	 * Captures the C-string argument.
+	 * @param val_ Value.
+	 */
+	BinaryScopeLogger& operator<<(const char * val_) {
+		binary::appendString(args, val_, std::strlen(val_));
+		return *this;
+	}
+
+	/*!
+	 * Captures the string argument.
+	 * @param val_ Value.
+	 */
+	BinaryScopeLogger& operator<<(const std::string & val_) {
+		binary::appendString(args, val_.data(), val_.size());
+		return *this;
+	}
+
+	/*!
+	 * Captures the structured record - the event name followed by pairs of keys and typed values (see LOG_KV).
+	 * @param event_ Name of the event.
+	 * @param fields_ Keys and values.
+	 */
+	template <typename... Fields>
+	BinaryScopeLogger& kv(const char * event_, const Fields&... fields_) {
+		static_assert(sizeof...(Fields) % 2 == 0, "LOG_KV expects the event name followed by key-value pairs");
+		binary::appendString(args, event_, std::strlen(event_), binary::EventArg);
+		captureFields(fields_...);
+		return *this;
+	}
+
+private:
+	/*!
+	 * Captures the key and value of the field, then the remaining fields.
+	 */
+	template <typename T, typename... Rest>
+	void captureFields(const char * key_, const T & val_, const Rest&... rest_) {
+		binary::appendString(args, key_, std::strlen(key_), binary::KeyArg);
+		(*this) << val_;
+		captureFields(rest_...);
+	}
+
+	/*!
+	 * Captures the key (given as string) and value of the field, then the remaining fields.
+	 */
+	template <typename T, typename... Rest>
+	void captureFields(const std::string & key_, const T & val_, const Rest&... rest_) {
+		binary::appendString(args, key_.data(), key_.size(), binary::KeyArg);
+		(*this) << val_;
+		captureFields(rest_...);
+	}
+
+	/*!
+	 * Ends the recursion.
+	 */
+	void captureFields() { }
+
+	/// Kinds of captured arguments.
+	typedef std::integral_constant<int, 0> OtherKind;
+	typedef std::integral_constant<int, 1> SignedKind;
+	typedef std::integral_constant<int, 2> UnsignedKind;
+	typedef std::integral_constant<int, 3> FloatingKind;
+	typedef std::integral_constant<int, 4> BoolKind;
+	typedef std::integral_constant<int, 5> CharKind;
+	typedef std::integral_constant<int, 6> PointerKind;
+
+	/*!
+	 * Trait returning kind of the argument.
+	 */
+	template <typename T>
+	struct ArgumentKind {
+		typedef typename std::conditional<std::is_same<T, bool>::value, BoolKind,
+			typename std::conditional<std::is_same<T, char>::value || std::is_same<T, signed char>::value || std::is_same<T, unsigned char>::value, CharKind,
+			typename std::conditional<std::is_integral<T>::value && std::is_signed<T>::value, SignedKind,
+			typename std::conditional<std::is_integral<T>::value, UnsignedKind,
+			typename std::conditional<std::is_floating_point<T>::value, FloatingKind,
+			typename std::conditional<std::is_pointer<T>::value && !std::is_same<T, char*>::value, PointerKind,
+			OtherKind>::type>::type>::type>::type>::type>::type type;
+	};
+
+	template <typename T>
+	void capture(const T & val_, SignedKind) {
+		args.push_back((char)binary::SignedArg);
+		binary::appendRaw(args, (int64_t)val_);
+	}
+
+	template <typename T>
+	void capture(const T & val_, UnsignedKind) {
+		args.push_back((char)binary::UnsignedArg);
+		binary::appendRaw(args, (uint64_t)val_);
+	}
+
+	template <typename T>
+	void capture(const T & val_, FloatingKind) {
+		args.push_back((char)binary::DoubleArg);
+		binary::appendRaw(args, (double)val_);
+	}
+
+	template <typename T>
+	void capture(const T & val_, BoolKind) {
+		args.push_back((char)binary::BoolArg);
+		binary::appendRaw(args, (uint8_t)val_);
+	}
+
+	template <typename T>
+	void capture(const T & val_, CharKind) {
+		args.push_back((char)binary::CharArg);
+		binary::appendRaw(args, (uint8_t)val_);
+	}
+
+	template <typename T>
+	void capture(const T & val_, PointerKind) {
+		args.push_back((char)binary::PointerArg);
+		binary::appendRaw(args, (uint64_t)(uintptr_t)val_);
+	}
+
+	template <typename T>
+	void capture(const T & val_, OtherKind) {
+		// Slow path - format the value as text (in the stream buffer, the message of the record holds the arguments).
+		stream->buf.reset();
+		(*stream) << val_;
+		binary::appendString(args, stream->buf.data(), stream->buf.size());
+	}
+
+	BinaryScopeLogger(const BinaryScopeLogger &);
+	BinaryScopeLogger& operator =(const BinaryScopeLogger&);
+
+	/// Parent class, to which the information will be sent.
+	Logger * parent;
+
+	/// Call site of the logger.
+	const LogSite & site;
+
+	/// Log (message) severity.
+	Severity_t severity;
+
+	/// Stream whose buffers are used.
+	LogStream * stream;
+
+	/// Captured arguments.
+	std::string & args;
+};
+
+} /* namespace logger */
+} /* namespace mic */
+
+#endif /* SRC_LOGGER_BINARYSCOPELOGGER_HPP_ */
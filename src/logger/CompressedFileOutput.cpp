@@ -0,0 +1,282 @@
+/*!
+ * Copyright (C) tkornuta, IBM Corporation 2015-2019
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+/*!
+ * \file CompressedFileOutput.cpp
+ * \brief Contains definitions of methods of the compressed file logger output.
+ * \author tkornuta
+ * \date Oct 17, 2026
+ */
+
+#include <logger/CompressedFileOutput.hpp>
+
+#include <stdexcept>
+#include <cstring>
+#include <cstdio>
+#include <cerrno>
+
+#include <fcntl.h>
+#include <unistd.h>
+#include <sys/stat.h>
+
+#include <zlib.h>
+
+namespace mic {
+namespace logger {
+
+namespace {
+
+/// Maximal number of blocks waiting for compression - logging threads wait when the compression cannot keep up.
+const size_t max_pending_blocks = 4;
+
+} /* namespace */
+
+CompressedFileOutput::CompressedFileOutput(const std::string & filename_, Severity_t sev_, size_t block_size_, int level_) :
+	LoggerOutput(sev_), filename(filename_), block_size(block_size_), level(level_), in_progress(0), stopping(false),
+	flush_interval(1000), max_size(0), max_files(5), fd(-1), size(0)
+{
+	open();
+	current.reserve(block_size);
+	compression_thread.reset(new boost::thread(&CompressedFileOutput::compressionThreadMain, this));
+}
+
+
+CompressedFileOutput::~CompressedFileOutput() {
+	{
+		boost::mutex::scoped_lock lock(mutex);
+		if (!current.empty())
+			submitBlock(lock);
+		stopping = true;
+		block_ready.notify_all();
+	}
+	// The thread compresses the pending blocks before it finishes.
+	compression_thread->join();
+	::close(fd);
+}
+
+
+void CompressedFileOutput::setRotation(size_t max_size_, unsigned int max_files_) {
+	boost::mutex::scoped_lock lock(mutex);
+	max_size = max_size_;
+	max_files = max_files_;
+}
+
+
+void CompressedFileOutput::setFlushInterval(unsigned int interval_ms_) {
+	boost::mutex::scoped_lock lock(mutex);
+	flush_interval = std::chrono::milliseconds(interval_ms_);
+}
+
+
+std::string CompressedFileOutput::rotatedName(unsigned int n_) const {
+	if (n_ == 0)
+		return filename;
+	// Keep the .gz extension, so the rotated files can be opened by the usual tools.
+	std::string suffix = "." + std::to_string(n_);
+	if ((filename.size() > 3) && (filename.compare(filename.size() - 3, 3, ".gz") == 0))
+		return filename.substr(0, filename.size() - 3) + suffix + ".gz";
+	return filename + suffix;
+}
+
+
+void CompressedFileOutput::print(const std::string & msg, Severity_t sev, const std::string & file, int line) const {
+	append("", 0, msg, sev, file, line);
+}
+
+
+void CompressedFileOutput::write(const LogRecord & rec_, const LogSite & site_) const {
+	if (!getTimestamps()) {
+		LoggerOutput::write(rec_, site_);
+		return;
+	}//: if
+	char prefix[prefix_length];
+	size_t len = formatPrefix(rec_, prefix);
+	append(prefix, len, RecordText::current().get(rec_), rec_.severity, site_.file_name, site_.line);
+}
+
+
+void CompressedFileOutput::append(const char * prefix_, size_t prefix_size_, const std::string & msg, Severity_t sev, const std::string & file, int line) const {
+	boost::mutex::scoped_lock lock(mutex);
+
+	// Format the line - as FileOutput does.
+	line_buffer.assign(prefix_, prefix_size_);
+	line_buffer += sev2str(sev);
+	if (sev <= Debug) {
+		char tmp[16];
+		int len = std::snprintf(tmp, sizeof(tmp), "%d", line);
+		line_buffer += " in ";
+		line_buffer += file;
+		line_buffer += " [";
+		line_buffer.append(tmp, len);
+		line_buffer += "]";
+	}//: if
+	line_buffer += ": ";
+	line_buffer += msg;
+	line_buffer += '\n';
+
+	if (!current.empty() && (current.size() + line_buffer.size() > block_size))
+		submitBlock(lock);
+	if (current.empty()) {
+		oldest = Clock::now();
+		// Let the compression thread start measuring the age of the block.
+		block_ready.notify_one();
+	}//: if
+	current += line_buffer;
+}
+
+
+void CompressedFileOutput::submitBlock(boost::mutex::scoped_lock & lock_) const {
+	while (pending.size() >= max_pending_blocks)
+		block_done.wait(lock_);
+
+	pending.push_back(std::string());
+	pending.back().swap(current);
+	// Reuse a block returned by the compression thread.
+	if (!free_blocks.empty()) {
+		current.swap(free_blocks.back());
+		free_blocks.pop_back();
+	} else
+		current.reserve(block_size);
+	block_ready.notify_one();
+}
+
+
+void CompressedFileOutput::flush() {
+	boost::mutex::scoped_lock lock(mutex);
+	if (!current.empty())
+		submitBlock(lock);
+	while (!pending.empty() || (in_progress > 0))
+		block_done.wait(lock);
+}
+
+
+void CompressedFileOutput::endOfBatch() {
+	boost::mutex::scoped_lock lock(mutex);
+	if (!current.empty() && (Clock::now() - oldest >= flush_interval))
+		submitBlock(lock);
+}
+
+
+void CompressedFileOutput::compressionThreadMain() {
+	std::string block;
+	boost::mutex::scoped_lock lock(mutex);
+	for (;;) {
+		while (pending.empty() && !stopping) {
+			if (current.empty()) {
+				block_ready.wait(lock);
+				continue;
+			}//: if
+			// Submit the current block once it is older than the flush interval - even when no more records arrive.
+			Clock::duration age = Clock::now() - oldest;
+			if (age >= flush_interval)
+				submitBlock(lock);
+			else
+				block_ready.timed_wait(lock, boost::posix_time::milliseconds(
+						std::chrono::duration_cast<std::chrono::milliseconds>(flush_interval - age).count() + 1));
+		}//: while
+		if (pending.empty())
+			break;
+
+		block.swap(pending.front());
+		pending.pop_front();
+		in_progress++;
+		lock.unlock();
+
+		compressBlock(block);
+		rotateIfNeeded();
+
+		lock.lock();
+		in_progress--;
+		// Return the buffer for reuse.
+		block.clear();
+		free_blocks.push_back(std::string());
+		free_blocks.back().swap(block);
+		block_done.notify_all();
+	}//: for
+}
+
+
+void CompressedFileOutput::compressBlock(const std::string & block_) {
+	z_stream zs;
+	std::memset(&zs, 0, sizeof(zs));
+	// Window bits 15 + 16 - gzip header and trailer, so every block is a complete gzip member.
+	if (deflateInit2(&zs, level, Z_DEFLATED, 15 + 16, 8, Z_DEFAULT_STRATEGY) != Z_OK)
+		return;
+	compressed.resize(deflateBound(&zs, block_.size()));
+	zs.next_in = (Bytef*)block_.data();
+	zs.avail_in = block_.size();
+	zs.next_out = &compressed[0];
+	zs.avail_out = compressed.size();
+	int res = deflate(&zs, Z_FINISH);
+	size_t out_size = compressed.size() - zs.avail_out;
+	deflateEnd(&zs);
+	if (res != Z_STREAM_END)
+		return;
+
+	// Write everything, handling partial writes.
+	const unsigned char * data = &compressed[0];
+	while (out_size > 0) {
+		ssize_t written = ::write(fd, data, out_size);
+		if (written < 0) {
+			if (errno == EINTR)
+				continue;
+			// Nothing we can do - drop the block.
+			break;
+		}//: if
+		data += written;
+		out_size -= written;
+		size += written;
+	}//: while
+}
+
+
+void CompressedFileOutput::open() {
+	fd = ::open(filename.c_str(), O_WRONLY | O_CREAT | O_APPEND, 0644);
+	if (fd < 0)
+		throw std::runtime_error("CompressedFileOutput: cannot open file " + filename + ": " + std::strerror(errno));
+	struct stat st;
+	size = (::fstat(fd, &st) == 0) ? (size_t)st.st_size : 0;
+}
+
+
+void CompressedFileOutput::rotateIfNeeded() {
+	size_t max_sz;
+	unsigned int files;
+	{
+		boost::mutex::scoped_lock lock(mutex);
+		max_sz = max_size;
+		files = max_files;
+	}
+	if ((max_sz == 0) || (size < max_sz))
+		return;
+
+	::close(fd);
+	// Shift the rotated files: name.(n-1).gz -> name.n.gz, ..., name.gz -> name.1.gz.
+	if (files > 0) {
+		for (unsigned int i = files - 1; i > 0; i--)
+			std::rename(rotatedName(i).c_str(), rotatedName(i + 1).c_str());
+		std::rename(filename.c_str(), rotatedName(1).c_str());
+	} else
+		std::remove(filename.c_str());
+	try {
+		open();
+	} catch (const std::runtime_error &) {
+		// Cannot throw from the compression thread - the following blocks are dropped.
+		fd = -1;
+	}//: catch
+}
+
+} /* namespace logger */
+} /* namespace mic */
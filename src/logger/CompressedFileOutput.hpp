@@ -0,0 +1,207 @@
+/*!
+ * Copyright (C) tkornuta, IBM Corporation 2015-2019
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+/*!
+ * \file CompressedFileOutput.hpp
+ * \brief Contains declaration of a logger output writing logs into gzip-compressed, rotated files (compressed on a background thread).
+ * \author tkornuta
+ * \date Oct 17, 2026
+ */
+
+#ifndef SRC_LOGGER_COMPRESSEDFILEOUTPUT_HPP_
+#define SRC_LOGGER_COMPRESSEDFILEOUTPUT_HPP_
+
+#include <logger/LoggerOutput.hpp>
+
+#include <boost/thread/mutex.hpp>
+#include <boost/thread/condition_variable.hpp>
+#include <boost/thread/thread.hpp>
+#include <boost/scoped_ptr.hpp>
+
+#include <deque>
+#include <vector>
+#include <chrono>
+
+namespace mic {
+namespace logger {
+
+/*!
+ * \brief Class writing logs into gzip-compressed text files - available when the toolchain is built with zlib (MIC_HAVE_ZLIB).
+ * Lines (formatted as by FileOutput) are gathered in blocks. Full blocks are compressed and written by a background thread,
+ * so the logging threads pay only for a memcpy. Every block is written as a separate gzip member, i.e. an independently
+ * decompressible frame: the file can be read by zcat/gzip, and a file truncated by a crash loses only its last, incomplete block.
+ * Files are rotated by their compressed size (run.log.gz -> run.log.1.gz -> ...).
+ * \author tkornuta
+ */
+class CompressedFileOutput : public LoggerOutput {
+public:
+	/*!
+	 * Constructor. Opens (appends to) the file and starts the compression thread.
+	 * @param filename_ Name of the file (e.g. run.log.gz).
+	 * @param sev_ Output severity level (LINFO as default).
+	 * @param block_size_ Size of the uncompressed block (compressed as a single frame).
+	 * @param level_ Compression level (1 - fastest, 9 - best).
+	 */
+	CompressedFileOutput(const std::string & filename_, Severity_t sev_ = LINFO, size_t block_size_ = 1 << 20, int level_ = 6);
+
+	/*!
+	 * Destructor. Compresses the remaining data, stops the thread and closes the file.
+	 */
+	virtual ~CompressedFileOutput();
+
+	/*!
+	 * Sets the rotation rules - the current file is renamed to name.1.gz (name.1.gz to name.2.gz etc.) and a new one is started.
+	 * @param max_size_ Maximal compressed size of the file in bytes (0 - no rotation).
+	 * @param max_files_ Number of kept rotated files.
+	 */
+	void setRotation(size_t max_size_, unsigned int max_files_ = 5);
+
+	/*!
+	 * Sets the maximal time the messages can stay in the (uncompressed) block - afterwards the compression thread submits the block by itself.
+	 * @param interval_ms_ Interval in ms.
+	 */
+	void setFlushInterval(unsigned int interval_ms_);
+
+	/*!
+	 * Puts the message into the block.
+	 * @param msg Message to be printed.
+	 * @param sev Severity level.
+	 * @param file File that called the log function.
+	 * @param line Line in which log function was called.
+	 */
+	void print(const std::string & msg, Severity_t sev, const std::string & file, int line) const;
+
+	/*!
+	 * Puts the record into the block - prefixed with the time and thread id when enabled (see setTimestamps()).
+	 * @param rec_ Record.
+	 * @param site_ Call site of the record.
+	 */
+	void write(const LogRecord & rec_, const LogSite & site_) const;
+
+	/*!
+	 * Compresses and writes everything logged so far (waits for the compression thread).
+	 */
+	void flush();
+
+	/*!
+	 * Passes the current block to the compression thread if it is older than the flush interval.
+	 */
+	void endOfBatch();
+
+	/*!
+	 * Returns the name of the n-th rotated file (0 - the current one), e.g. run.log.2.gz.
+	 */
+	std::string rotatedName(unsigned int n_) const;
+
+private:
+	/// Clock used for measuring time intervals.
+	typedef std::chrono::steady_clock Clock;
+
+	/*!
+	 * Formats the line and puts it into the current block.
+	 */
+	void append(const char * prefix_, size_t prefix_size_, const std::string & msg, Severity_t sev, const std::string & file, int line) const;
+
+	/*!
+	 * Passes the current block to the compression thread - called under mutex.
+	 * Waits when too many blocks are already waiting (so memory stays bounded).
+	 */
+	void submitBlock(boost::mutex::scoped_lock & lock_) const;
+
+	/*!
+	 * Main function of the compression thread.
+	 */
+	void compressionThreadMain();
+
+	/*!
+	 * Compresses the block into a single gzip member and writes it - called by the compression thread (without mutex).
+	 */
+	void compressBlock(const std::string & block_);
+
+	/*!
+	 * Opens the file.
+	 */
+	void open();
+
+	/*!
+	 * Rotates the file if it exceeds the maximal compressed size - called by the compression thread.
+	 */
+	void rotateIfNeeded();
+
+	/// Name of the file.
+	std::string filename;
+
+	/// Size of the block.
+	size_t block_size;
+
+	/// Compression level.
+	int level;
+
+	/// Mutex protecting the blocks and the settings.
+	mutable boost::mutex mutex;
+
+	/// Condition signalled when a block is submitted, the first line is put into the current block or the thread is stopped.
+	mutable boost::condition_variable block_ready;
+
+	/// Condition signalled when a block is written.
+	mutable boost::condition_variable block_done;
+
+	/// Block currently being filled.
+	mutable std::string current;
+
+	/// Time of writing the first line into the (empty) current block.
+	mutable Clock::time_point oldest;
+
+	/// Blocks waiting for compression.
+	mutable std::deque<std::string> pending;
+
+	/// Empty blocks (with reserved capacity) ready for reuse.
+	mutable std::vector<std::string> free_blocks;
+
+	/// Number of blocks being compressed (taken from pending, not written yet).
+	mutable size_t in_progress;
+
+	/// Flag used for stopping the compression thread.
+	bool stopping;
+
+	/// Maximal time the data can stay in the current block.
+	std::chrono::milliseconds flush_interval;
+
+	/// Maximal compressed size of the file (0 - unlimited).
+	size_t max_size;
+
+	/// Number of kept rotated files.
+	unsigned int max_files;
+
+	/// File descriptor (used by the compression thread only).
+	int fd;
+
+	/// Current size of the file (used by the compression thread only).
+	size_t size;
+
+	/// Buffer for the compressed data (used by the compression thread only).
+	std::vector<unsigned char> compressed;
+
+	/// Buffer used for formatting of the line.
+	mutable std::string line_buffer;
+
+	/// Compression thread.
+	boost::scoped_ptr<boost::thread> compression_thread;
+};
+
+} /* namespace logger */
+} /* namespace mic */
+
+#endif /* SRC_LOGGER_COMPRESSEDFILEOUTPUT_HPP_ */
@@ -186,12 +186,14 @@ class ConsoleOutput : public LoggerOutput {
 public:
 	/*!
 	 * Constructor. Sets default severity level (LINFO as default).
+	 * The console accepts forced records (see LoggerOutput::setForcedRecords()), so the sites enabled by dynamic debug rules
+	 * (or by levels of their categories) are printed regardless of the output level.
 	 * @param sev Default output severity level.
 	 */
 	ConsoleOutput(Severity_t sev = LINFO) :
 		LoggerOutput(sev)
 	{
-
+		setForcedRecords(true);
 	}
 
 	/*!
@@ -235,7 +237,28 @@ public:
 			break;
 		}
 
-		std::cout << ": " << msg << std::endl;
+		std::cout << ": " << msg << '\n';
+	}
+
+	/*!
+	 * Prints the record - prefixed with the time and thread id when enabled (see setTimestamps()).
+	 * @param rec_ Record.
+	 * @param site_ Call site of the record.
+	 */
+	void write(const LogRecord & rec_, const LogSite & site_) const {
+		if (getTimestamps()) {
+			char prefix[prefix_length];
+			size_t len = formatPrefix(rec_, prefix);
+			std::cout.write(prefix, len);
+		}//: if
+		LoggerOutput::write(rec_, site_);
+	}
+
+	/*!
+	 * Flushes the console output.
+	 */
+	void flush() {
+		std::cout.flush();
 	}
 };
 
@@ -0,0 +1,331 @@
+/*!
+ * Copyright (C) tkornuta, IBM Corporation 2015-2019
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+/*!
+ * \file FileOutput.cpp
+ * \brief Contains definitions of methods of the buffered file logger output.
+ * \author tkornuta
+ * \date Oct 17, 2026
+ */
+
+#include <logger/FileOutput.hpp>
+
+#include <stdexcept>
+#include <cstring>
+#include <cstdio>
+#include <cerrno>
+
+#include <fcntl.h>
+#include <unistd.h>
+#include <sys/stat.h>
+#include <sys/uio.h>
+
+namespace mic {
+namespace logger {
+
+FileOutput::FileOutput(const std::string & filename_, Severity_t sev_, bool split_by_severity_, size_t buffer_size_) :
+	LoggerOutput(sev_), stopping(false), sinks(split_by_severity_ ? (Fatal + 1) : 1), split_by_severity(split_by_severity_),
+	max_size(0), max_age(0), max_files(5), fsync_policy(FsyncNever), fsync_period(1000), last_fsync(Clock::now()),
+	flush_interval(1000)
+{
+	for (size_t i = 0; i < sinks.size(); i++) {
+		Sink & sink = sinks[i];
+		if (split_by_severity) {
+			// Insert the severity name before the extension.
+			size_t dot = filename_.find_last_of('.');
+			size_t slash = filename_.find_last_of('/');
+			if ((dot == std::string::npos) || ((slash != std::string::npos) && (dot < slash)))
+				sink.filename = filename_ + "." + sev2str((Severity_t)i);
+			else
+				sink.filename = filename_.substr(0, dot) + "." + sev2str((Severity_t)i) + filename_.substr(dot);
+		} else
+			sink.filename = filename_;
+		sink.buffer.resize(buffer_size_);
+		if (!open(sink))
+			throw std::runtime_error("FileOutput: cannot open file " + sink.filename + ": " + std::strerror(errno));
+	}//: for
+	timer_thread.reset(new boost::thread(&FileOutput::timerThreadMain, this));
+}
+
+
+FileOutput::~FileOutput() {
+	{
+		boost::mutex::scoped_lock lock(mutex);
+		stopping = true;
+		data_ready.notify_all();
+	}
+	timer_thread->join();
+	flush();
+	for (size_t i = 0; i < sinks.size(); i++) {
+		if (sinks[i].fd >= 0)
+			::close(sinks[i].fd);
+	}//: for
+}
+
+
+void FileOutput::setRotation(size_t max_size_, unsigned int max_age_s_, unsigned int max_files_) {
+	boost::mutex::scoped_lock lock(mutex);
+	max_size = max_size_;
+	max_age = std::chrono::seconds(max_age_s_);
+	max_files = max_files_;
+}
+
+
+void FileOutput::setFsyncPolicy(FsyncPolicy_t policy_, unsigned int period_ms_) {
+	boost::mutex::scoped_lock lock(mutex);
+	fsync_policy = policy_;
+	fsync_period = std::chrono::milliseconds(period_ms_);
+}
+
+
+void FileOutput::setFlushInterval(unsigned int interval_ms_) {
+	boost::mutex::scoped_lock lock(mutex);
+	flush_interval = std::chrono::milliseconds(interval_ms_);
+}
+
+
+void FileOutput::print(const std::string & msg, Severity_t sev, const std::string & file, int line) const {
+	append("", 0, msg, sev, file, line);
+}
+
+
+void FileOutput::write(const LogRecord & rec_, const LogSite & site_) const {
+	if (!getTimestamps()) {
+		LoggerOutput::write(rec_, site_);
+		return;
+	}//: if
+	char prefix[prefix_length];
+	size_t len = formatPrefix(rec_, prefix);
+	append(prefix, len, RecordText::current().get(rec_), rec_.severity, site_.file_name, site_.line);
+}
+
+
+void FileOutput::append(const char * prefix_, size_t prefix_size_, const std::string & msg, Severity_t sev, const std::string & file, int line) const {
+	boost::mutex::scoped_lock lock(mutex);
+	Sink & sink = split_by_severity ? sinks[sev] : sinks[0];
+
+	// Format the line - as ConsoleOutput does, without colours.
+	line_buffer.assign(prefix_, prefix_size_);
+	line_buffer += sev2str(sev);
+	if (sev <= Debug) {
+		char tmp[16];
+		int len = std::snprintf(tmp, sizeof(tmp), "%d", line);
+		line_buffer += " in ";
+		line_buffer += file;
+		line_buffer += " [";
+		line_buffer.append(tmp, len);
+		line_buffer += "]";
+	}//: if
+	line_buffer += ": ";
+	line_buffer += msg;
+	line_buffer += '\n';
+
+	put(sink, line_buffer.data(), line_buffer.size(), sev);
+}
+
+
+void FileOutput::appendLine(const char * line_, size_t size_, Severity_t sev_) const {
+	boost::mutex::scoped_lock lock(mutex);
+	put(split_by_severity ? sinks[sev_] : sinks[0], line_, size_, sev_);
+}
+
+
+void FileOutput::put(Sink & sink_, const char * line_, size_t size_, Severity_t sev_) const {
+	if (sink_.used + size_ > sink_.buffer.size()) {
+		// Buffer full - write it together with the line.
+		write(sink_, line_, size_);
+	} else {
+		if (sink_.used == 0) {
+			sink_.oldest = Clock::now();
+			// Let the timer thread start measuring the age of the buffer.
+			data_ready.notify_one();
+		}//: if
+		std::memcpy(&sink_.buffer[sink_.used], line_, size_);
+		sink_.used += size_;
+	}//: else
+
+	if ((fsync_policy == FsyncOnWarning) && (sev_ >= Warning))
+		sync(sink_);
+
+	rotateIfNeeded(sink_);
+}
+
+
+void FileOutput::flush() {
+	boost::mutex::scoped_lock lock(mutex);
+	for (size_t i = 0; i < sinks.size(); i++) {
+		if (fsync_policy == FsyncNever)
+			write(sinks[i]);
+		else
+			sync(sinks[i]);
+	}//: for
+}
+
+
+void FileOutput::endOfBatch() {
+	boost::mutex::scoped_lock lock(mutex);
+	writeAged(Clock::now());
+}
+
+
+void FileOutput::writeAged(Clock::time_point now_) const {
+	for (size_t i = 0; i < sinks.size(); i++) {
+		if ((sinks[i].used > 0) && (now_ - sinks[i].oldest >= flush_interval))
+			write(sinks[i]);
+	}//: for
+
+	if ((fsync_policy == FsyncPeriodic) && (now_ - last_fsync >= fsync_period)) {
+		for (size_t i = 0; i < sinks.size(); i++)
+			sync(sinks[i]);
+		last_fsync = now_;
+	}//: if
+}
+
+
+void FileOutput::timerThreadMain() {
+	boost::mutex::scoped_lock lock(mutex);
+	while (!stopping) {
+		// Find the earliest moment something has to be written or synced.
+		bool pending = false;
+		Clock::time_point deadline;
+		for (size_t i = 0; i < sinks.size(); i++) {
+			if ((sinks[i].used > 0) && (!pending || (sinks[i].oldest + flush_interval < deadline))) {
+				deadline = sinks[i].oldest + flush_interval;
+				pending = true;
+			}//: if
+			if ((fsync_policy == FsyncPeriodic) && (sinks[i].used > 0 || sinks[i].dirty) && (!pending || (last_fsync + fsync_period < deadline))) {
+				deadline = last_fsync + fsync_period;
+				pending = true;
+			}//: if
+		}//: for
+		if (!pending) {
+			data_ready.wait(lock);
+			continue;
+		}//: if
+
+		Clock::time_point now = Clock::now();
+		if (now >= deadline)
+			writeAged(now);
+		else
+			data_ready.timed_wait(lock, boost::posix_time::milliseconds(
+					std::chrono::duration_cast<std::chrono::milliseconds>(deadline - now).count() + 1));
+	}//: while
+}
+
+
+bool FileOutput::open(Sink & sink_) const {
+	sink_.opened = Clock::now();
+	sink_.fd = ::open(sink_.filename.c_str(), O_WRONLY | O_CREAT | O_APPEND, 0644);
+	if (sink_.fd < 0)
+		return false;
+	struct stat st;
+	sink_.size = (::fstat(sink_.fd, &st) == 0) ? (size_t)st.st_size : 0;
+	return true;
+}
+
+
+void FileOutput::write(Sink & sink_, const char * data_, size_t size_) const {
+	struct iovec iov[2];
+	int iovcnt = 0;
+	if (sink_.used > 0) {
+		iov[iovcnt].iov_base = &sink_.buffer[0];
+		iov[iovcnt].iov_len = sink_.used;
+		iovcnt++;
+	}//: if
+	if (size_ > 0) {
+		iov[iovcnt].iov_base = const_cast<char*>(data_);
+		iov[iovcnt].iov_len = size_;
+		iovcnt++;
+	}//: if
+
+	// Write everything, handling partial writes.
+	bool written_any = false;
+	struct iovec * cur = iov;
+	while (iovcnt > 0) {
+		ssize_t res = ::writev(sink_.fd, cur, iovcnt);
+		if (res < 0) {
+			if (errno == EINTR)
+				continue;
+			// Nothing we can do - drop the data.
+			break;
+		}//: if
+		sink_.size += res;
+		written_any = written_any || (res > 0);
+		size_t written = (size_t)res;
+		while ((iovcnt > 0) && (written >= cur->iov_len)) {
+			written -= cur->iov_len;
+			cur++;
+			iovcnt--;
+		}//: while
+		if (iovcnt > 0) {
+			cur->iov_base = (char*)cur->iov_base + written;
+			cur->iov_len -= written;
+		}//: if
+	}//: while
+
+	sink_.used = 0;
+	if (written_any && !sink_.dirty) {
+		sink_.dirty = true;
+		// Let the timer thread schedule the periodic fsync.
+		if (fsync_policy == FsyncPeriodic)
+			data_ready.notify_one();
+	}//: if
+}
+
+
+void FileOutput::sync(Sink & sink_) const {
+	if (sink_.used > 0)
+		write(sink_);
+	if (sink_.dirty) {
+		::fsync(sink_.fd);
+		sink_.dirty = false;
+	}//: if
+}
+
+
+void FileOutput::rotateIfNeeded(Sink & sink_) const {
+	// The rotated file could not be reopened - retry at most once per second, the messages are dropped meanwhile.
+	if (sink_.fd < 0) {
+		if (Clock::now() - sink_.opened >= std::chrono::seconds(1))
+			open(sink_);
+		return;
+	}//: if
+
+	bool too_big = (max_size > 0) && (sink_.size + sink_.used >= max_size);
+	bool too_old = (max_age.count() > 0) && (Clock::now() - sink_.opened >= max_age);
+	if (!too_big && !too_old)
+		return;
+
+	write(sink_);
+	::close(sink_.fd);
+
+	// Shift the rotated files: name.(n-1) -> name.n, ..., name -> name.1.
+	if (max_files > 0) {
+		for (unsigned int i = max_files - 1; i > 0; i--) {
+			std::string from = sink_.filename + "." + std::to_string(i);
+			std::string to = sink_.filename + "." + std::to_string(i + 1);
+			std::rename(from.c_str(), to.c_str());
+		}//: for
+		std::rename(sink_.filename.c_str(), (sink_.filename + ".1").c_str());
+	} else
+		std::remove(sink_.filename.c_str());
+
+	// Cannot throw from the logging path - report the error and keep running.
+	if (!open(sink_))
+		std::fprintf(stderr, "FileOutput: cannot reopen file %s: %s\n", sink_.filename.c_str(), std::strerror(errno));
+}
+
+} /* namespace logger */
+} /* namespace mic */
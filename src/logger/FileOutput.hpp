@@ -0,0 +1,256 @@
+/*!
+ * Copyright (C) tkornuta, IBM Corporation 2015-2019
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+/*!
+ * \file FileOutput.hpp
+ * \brief Contains declaration of a buffered logger output class writing logs into (rotated) text files.
+ * \author tkornuta
+ * \date Oct 17, 2026
+ */
+
+#ifndef SRC_LOGGER_FILEOUTPUT_HPP_
+#define SRC_LOGGER_FILEOUTPUT_HPP_
+
+#include <logger/LoggerOutput.hpp>
+
+#include <boost/thread/mutex.hpp>
+#include <boost/thread/condition_variable.hpp>
+#include <boost/thread/thread.hpp>
+#include <boost/scoped_ptr.hpp>
+
+#include <vector>
+#include <chrono>
+
+namespace mic {
+namespace logger {
+
+/*!
+ * \brief Policy of synchronizing the log files with the disk (fsync).
+ * \author tkornuta
+ */
+enum FsyncPolicy_t
+{
+	FsyncNever = 0, ///< Leave it to the operating system.
+	FsyncOnWarning, ///< Write and sync the file after every message of WARNING or higher severity.
+	FsyncPeriodic ///< Write and sync the files periodically.
+};
+
+/*!
+ * \brief Class responsible for writing logs into text files.
+ * Messages are gathered in a large user-space buffer, which is written (with a single writev call) when it is full,
+ * when the buffered data gets older than the flush interval or when the logger is flushed - there is no flush per message.
+ * The aged data (and the periodic fsync) is handled by a background timer thread, so an idle process does not keep its last messages in memory.
+ * Optionally, messages of every severity are written into separate files and files are rotated by size and/or age.
+ * When a rotated file cannot be reopened, the error is reported on stderr, messages are dropped and the file is reopened later.
+ * \author tkornuta
+ */
+class FileOutput : public LoggerOutput {
+public:
+	/*!
+	 * Constructor. Opens (appends to) the log file(s).
+	 * @param filename_ Name of the log file. When split by severity, the severity name is inserted before the extension (e.g. run.WARNING.log).
+	 * @param sev_ Default output severity level (LINFO as default).
+	 * @param split_by_severity_ If true, messages of every severity are written into separate files.
+	 * @param buffer_size_ Size of the user-space buffer (per file).
+	 */
+	FileOutput(const std::string & filename_, Severity_t sev_ = LINFO, bool split_by_severity_ = false, size_t buffer_size_ = 1 << 20);
+
+	/*!
+	 * Destructor. Stops the timer thread, writes the buffered data and closes the files.
+	 */
+	virtual ~FileOutput();
+
+	/*!
+	 * Sets the rotation rules - the current file is renamed to name.1 (name.1 to name.2 etc.) and a new one is started.
+	 * @param max_size_ Maximal size of the file in bytes (0 - no rotation by size).
+	 * @param max_age_s_ Maximal age of the file in seconds (0 - no rotation by time).
+	 * @param max_files_ Number of kept rotated files.
+	 */
+	void setRotation(size_t max_size_, unsigned int max_age_s_ = 0, unsigned int max_files_ = 5);
+
+	/*!
+	 * Sets the fsync policy.
+	 * @param policy_ Policy.
+	 * @param period_ms_ Period of fsync (used by FsyncPeriodic).
+	 */
+	void setFsyncPolicy(FsyncPolicy_t policy_, unsigned int period_ms_ = 1000);
+
+	/*!
+	 * Sets the maximal time the messages can stay in the buffer - afterwards the timer thread writes them, even when no more messages arrive.
+	 * @param interval_ms_ Interval in ms.
+	 */
+	void setFlushInterval(unsigned int interval_ms_);
+
+	/*!
+	 * Puts the message into the buffer.
+	 * @param msg Message to be printed.
+	 * @param sev Severity level.
+	 * @param file File that called the log function.
+	 * @param line Line in which log function was called.
+	 */
+	void print(const std::string & msg, Severity_t sev, const std::string & file, int line) const;
+
+	/*!
+	 * Puts the record into the buffer - prefixed with the time and thread id when enabled (see setTimestamps()).
+	 * @param rec_ Record.
+	 * @param site_ Call site of the record.
+	 */
+	void write(const LogRecord & rec_, const LogSite & site_) const;
+
+	/*!
+	 * Writes the buffered data into files.
+	 */
+	void flush();
+
+	/*!
+	 * Writes the buffered data if it is older than the flush interval, syncs the files according to the fsync policy.
+	 */
+	void endOfBatch();
+
+protected:
+	/*!
+	 * Puts the already formatted line (with the trailing newline) into the buffer - used by derived outputs formatting the lines on their own.
+	 * @param line_ Line.
+	 * @param size_ Length of the line.
+	 * @param sev_ Severity of the message.
+	 */
+	void appendLine(const char * line_, size_t size_, Severity_t sev_) const;
+
+private:
+	/// Clock used for measuring time intervals.
+	typedef std::chrono::steady_clock Clock;
+
+	/*!
+	 * \brief Single log file with its buffer.
+	 */
+	struct Sink {
+		/// Name of the file.
+		std::string filename;
+
+		/// File descriptor.
+		int fd;
+
+		/// Current size of the file.
+		size_t size;
+
+		/// Time of opening of the file.
+		Clock::time_point opened;
+
+		/// Buffer.
+		std::vector<char> buffer;
+
+		/// Number of bytes used in buffer.
+		size_t used;
+
+		/// Time of writing the first message into the (empty) buffer.
+		Clock::time_point oldest;
+
+		/// Flag denoting that the file was written but not synced.
+		bool dirty;
+
+		Sink() : fd(-1), size(0), used(0), dirty(false) { }
+	};
+
+	/*!
+	 * Formats the line and puts it into the buffer of the sink.
+	 * @param prefix_ Prefix of the line.
+	 * @param prefix_size_ Length of the prefix.
+	 */
+	void append(const char * prefix_, size_t prefix_size_, const std::string & msg, Severity_t sev, const std::string & file, int line) const;
+
+	/*!
+	 * Puts the line into the buffer of the sink, writes, syncs and rotates the file when needed - called under mutex.
+	 */
+	void put(Sink & sink_, const char * line_, size_t size_, Severity_t sev_) const;
+
+	/*!
+	 * Opens the file of the sink.
+	 * @return False if the file could not be opened (errno is set).
+	 */
+	bool open(Sink & sink_) const;
+
+	/*!
+	 * Writes the data older than the flush interval and syncs the files according to the fsync policy - called under mutex.
+	 * @param now_ Current time.
+	 */
+	void writeAged(Clock::time_point now_) const;
+
+	/*!
+	 * Main function of the timer thread.
+	 */
+	void timerThreadMain();
+
+	/*!
+	 * Writes the buffer of the sink (and optionally the additional data) into the file.
+	 */
+	void write(Sink & sink_, const char * data_ = NULL, size_t size_ = 0) const;
+
+	/*!
+	 * Writes the buffer of the sink and syncs its file.
+	 */
+	void sync(Sink & sink_) const;
+
+	/*!
+	 * Rotates the file of the sink if it is too big or too old.
+	 */
+	void rotateIfNeeded(Sink & sink_) const;
+
+	/// Mutex protecting the sinks.
+	mutable boost::mutex mutex;
+
+	/// Condition signalled when data is put into an empty buffer, a file gets dirty or the timer thread is stopped.
+	mutable boost::condition_variable data_ready;
+
+	/// Flag used for stopping the timer thread.
+	bool stopping;
+
+	/// Sinks - a single one or one per severity level.
+	mutable std::vector<Sink> sinks;
+
+	/// Flag denoting whether messages are split into files by severity.
+	bool split_by_severity;
+
+	/// Maximal size of file (0 - unlimited).
+	size_t max_size;
+
+	/// Maximal age of file (0 - unlimited).
+	std::chrono::seconds max_age;
+
+	/// Number of kept rotated files.
+	unsigned int max_files;
+
+	/// Fsync policy.
+	FsyncPolicy_t fsync_policy;
+
+	/// Period of fsync.
+	std::chrono::milliseconds fsync_period;
+
+	/// Time of last periodic fsync.
+	mutable Clock::time_point last_fsync;
+
+	/// Maximal time the data can stay in the buffer.
+	std::chrono::milliseconds flush_interval;
+
+	/// Buffer used for formatting of the line.
+	mutable std::string line_buffer;
+
+	/// Timer thread writing the aged data.
+	boost::scoped_ptr<boost::thread> timer_thread;
+};
+
+} /* namespace logger */
+} /* namespace mic */
+
+#endif /* SRC_LOGGER_FILEOUTPUT_HPP_ */
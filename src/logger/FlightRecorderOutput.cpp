@@ -0,0 +1,124 @@
+/*!
+ * Copyright (C) tkornuta, IBM Corporation 2015-2019
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+/*!
+ * \file FlightRecorderOutput.cpp
+ * \brief Contains definitions of methods of the FlightRecorderOutput class.
+ * \author tkornuta
+ * \date Oct 17, 2026
+ */
+
+#include <logger/FlightRecorderOutput.hpp>
+
+#include <stdexcept>
+#include <algorithm>
+#include <fstream>
+#include <iterator>
+#include <cstdio>
+
+#include <fcntl.h>
+#include <unistd.h>
+#include <sys/mman.h>
+
+namespace mic {
+namespace logger {
+
+boost::atomic<FlightRecorderOutput*> FlightRecorderOutput::active_recorder(NULL);
+
+
+FlightRecorderOutput::FlightRecorderOutput(const std::string & filename_, size_t slots_, size_t slot_size_, Severity_t sev_) :
+	LoggerOutput(sev_), filename(filename_), data(NULL)
+{
+	size_t slots = std::max<size_t>(slots_, 1);
+	size_t slot_size = LogRing::slotSize(slot_size_);
+	// Keep the ring of the previous run.
+	if (access(filename.c_str(), F_OK) == 0)
+		std::rename(filename.c_str(), (filename + ".prev").c_str());
+
+	size = LogRing::mappingSize(slots, slot_size);
+	int fd = ::open(filename.c_str(), O_RDWR | O_CREAT | O_TRUNC, 0644);
+	if (fd < 0)
+		throw std::runtime_error("FlightRecorderOutput: cannot open file " + filename);
+	if (ftruncate(fd, size) != 0) {
+		::close(fd);
+		throw std::runtime_error("FlightRecorderOutput: cannot resize file " + filename);
+	}//: if
+	void * ptr = mmap(NULL, size, PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+	::close(fd);
+	if (ptr == MAP_FAILED)
+		throw std::runtime_error("FlightRecorderOutput: cannot map file " + filename);
+	data = (char*)ptr;
+	ring.reset(new LogRing(data, slots, slot_size));
+
+	active_recorder.store(this, boost::memory_order_release);
+}
+
+
+FlightRecorderOutput::~FlightRecorderOutput() {
+	FlightRecorderOutput * self = this;
+	active_recorder.compare_exchange_strong(self, NULL);
+	msync(data, size, MS_ASYNC);
+	munmap(data, size);
+}
+
+
+void FlightRecorderOutput::write(const LogRecord & rec_, const LogSite & site_) const {
+	store(rec_.message.data(), rec_.message.size(), rec_.binary, rec_.severity, site_.file, site_.line, rec_.timestamp, rec_.thread);
+}
+
+
+void FlightRecorderOutput::print(const std::string & msg, Severity_t sev, const std::string & file, int line) const {
+	store(msg.data(), msg.size(), false, sev, file.c_str(), line, monotonicNs(), threadId());
+}
+
+
+void FlightRecorderOutput::printBinary(const std::string & args, Severity_t sev, const std::string & file, int line) const {
+	store(args.data(), args.size(), true, sev, file.c_str(), line, monotonicNs(), threadId());
+}
+
+
+void FlightRecorderOutput::store(const char * msg_, size_t size_, bool binary_, Severity_t sev_, const char * file_, int line_, int64_t timestamp_, uint32_t thread_) const {
+	ring->store(msg_, size_, binary_, sev_, file_, line_, timestamp_, thread_);
+
+	// The process is about to die - make sure the trail reaches the disk.
+	if (sev_ >= Fatal)
+		msync(data, size, MS_SYNC);
+}
+
+
+void FlightRecorderOutput::flush() {
+	msync(data, size, MS_ASYNC);
+}
+
+
+void FlightRecorderOutput::dump(std::ostream & os_) const {
+	ring->dump(os_);
+}
+
+
+bool FlightRecorderOutput::dumpFile(const std::string & filename_, std::ostream & os_) {
+	std::ifstream in(filename_.c_str(), std::ios::binary);
+	if (!in)
+		return false;
+	std::string contents((std::istreambuf_iterator<char>(in)), std::istreambuf_iterator<char>());
+	LogRing ring(contents.data(), contents.size());
+	if (!ring.valid())
+		return false;
+	ring.dump(os_);
+	return true;
+}
+
+} /* namespace logger */
+} /* namespace mic */
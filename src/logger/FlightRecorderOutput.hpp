@@ -0,0 +1,151 @@
+/*!
+ * Copyright (C) tkornuta, IBM Corporation 2015-2019
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+/*!
+ * \file FlightRecorderOutput.hpp
+ * \brief Contains declaration of the FlightRecorderOutput class, keeping the most recent log records in a memory-mapped ring file.
+ * \author tkornuta
+ * \date Oct 17, 2026
+ */
+
+#ifndef SRC_LOGGER_FLIGHTRECORDEROUTPUT_HPP_
+#define SRC_LOGGER_FLIGHTRECORDEROUTPUT_HPP_
+
+#include <logger/LoggerOutput.hpp>
+#include <logger/LogRing.hpp>
+
+#include <boost/atomic.hpp>
+#include <boost/scoped_ptr.hpp>
+
+#include <ostream>
+#include <string>
+
+namespace mic {
+namespace logger {
+
+/*!
+ * \brief Flight recorder - keeps the last N records (usually of all severities, including the ones not printed by other outputs)
+ * in a ring of fixed-size slots (see LogRing) in a memory-mapped file.
+ * Storing a record is a memcpy into the shared mapping, with no system calls, and the data survives crash of the process
+ * (the pages belong to the file). The ring can be dumped with the mic_logdump tool, the key handler or dump().
+ * When the file exists on startup, it is kept as filename.prev - so the trail of the previous (crashed) run is not overwritten.
+ * Messages longer than the slot are truncated.
+ * \author tkornuta
+ */
+class FlightRecorderOutput : public LoggerOutput {
+public:
+	/*!
+	 * Constructor. Creates the ring file and maps it into memory.
+	 * @param filename_ Name of the ring file.
+	 * @param slots_ Number of slots (records kept).
+	 * @param slot_size_ Size of the slot in bytes (header of the slot included).
+	 * @param sev_ Output severity level (LTRACE as default - records everything).
+	 */
+	FlightRecorderOutput(const std::string & filename_, size_t slots_ = 4096, size_t slot_size_ = 256, Severity_t sev_ = LTRACE);
+
+	/*!
+	 * Destructor. Unmaps the file (the file is kept).
+	 */
+	virtual ~FlightRecorderOutput();
+
+	/*!
+	 * Stores the record in the ring. Records of LFATAL severity are synchronously written to disk.
+	 * @param rec_ Record.
+	 * @param site_ Call site of the record.
+	 */
+	void write(const LogRecord & rec_, const LogSite & site_) const;
+
+	/*!
+	 * Stores the message in the ring.
+	 * @param msg Message to be stored.
+	 * @param sev Severity level.
+	 * @param file File that called the log function.
+	 * @param line Line in which log function was called.
+	 */
+	void print(const std::string & msg, Severity_t sev, const std::string & file, int line) const;
+
+	/*!
+	 * Stores the message with binary arguments in the ring (arguments are formatted when dumped).
+	 * @param args Binary arguments.
+	 * @param sev Severity level.
+	 * @param file File that called the log function.
+	 * @param line Line in which log function was called.
+	 */
+	void printBinary(const std::string & args, Severity_t sev, const std::string & file, int line) const;
+
+	/*!
+	 * Schedules writing of the mapped file to disk (without waiting).
+	 */
+	void flush();
+
+	/*!
+	 * Does nothing - the data is already in the file mapping.
+	 */
+	void endOfBatch() { }
+
+	/*!
+	 * Prints the records stored in the ring - from the oldest one.
+	 * @param os_ Output stream.
+	 */
+	void dump(std::ostream & os_) const;
+
+	/*!
+	 * Returns the name of the ring file.
+	 */
+	const std::string & getFilename() const {
+		return filename;
+	}
+
+	/*!
+	 * Prints the records stored in the ring file (e.g. left by a crashed process) - from the oldest one.
+	 * @param filename_ Name of the ring file.
+	 * @param os_ Output stream.
+	 * @return False if the file cannot be read or is not a flight recorder file.
+	 */
+	static bool dumpFile(const std::string & filename_, std::ostream & os_);
+
+	/*!
+	 * Returns the most recently created flight recorder (NULL if there is none) - used e.g. by the key handler.
+	 */
+	static FlightRecorderOutput * active() {
+		return active_recorder.load(boost::memory_order_acquire);
+	}
+
+private:
+	/*!
+	 * Stores the message in the next slot of the ring.
+	 */
+	void store(const char * msg_, size_t size_, bool binary_, Severity_t sev_, const char * file_, int line_, int64_t timestamp_, uint32_t thread_) const;
+
+	/// Name of the ring file.
+	std::string filename;
+
+	/// Mapped file.
+	char * data;
+
+	/// Size of the mapped file.
+	size_t size;
+
+	/// Ring in the mapped file.
+	boost::scoped_ptr<LogRing> ring;
+
+	/// The most recently created recorder.
+	static boost::atomic<FlightRecorderOutput*> active_recorder;
+};
+
+} /* namespace logger */
+} /* namespace mic */
+
+#endif /* SRC_LOGGER_FLIGHTRECORDEROUTPUT_HPP_ */
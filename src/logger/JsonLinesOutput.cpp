@@ -0,0 +1,221 @@
+/*!
+ * Copyright (C) tkornuta, IBM Corporation 2015-2019
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+/*!
+ * \file JsonLinesOutput.cpp
+ * \brief Contains definitions of methods of the JsonLinesOutput class.
+ * \author tkornuta
+ * \date Oct 17, 2026
+ */
+
+#include <logger/JsonLinesOutput.hpp>
+#include <logger/NumberFormat.hpp>
+
+#include <sstream>
+#include <cstring>
+#include <cstdio>
+
+namespace mic {
+namespace logger {
+
+JsonLinesOutput::JsonLinesOutput(const std::string & filename_, Severity_t sev_, size_t buffer_size_) :
+	FileOutput(filename_, sev_, false, buffer_size_)
+{
+
+}
+
+
+void JsonLinesOutput::write(const LogRecord & rec_, const LogSite & site_) const {
+	writeLine(rec_.message.data(), rec_.message.size(), rec_.binary, rec_.severity, site_.file, site_.line, rec_.timestamp, rec_.thread);
+}
+
+
+void JsonLinesOutput::print(const std::string & msg, Severity_t sev, const std::string & file, int line) const {
+	writeLine(msg.data(), msg.size(), false, sev, file.c_str(), line, monotonicNs(), threadId());
+}
+
+
+void JsonLinesOutput::printBinary(const std::string & args, Severity_t sev, const std::string & file, int line) const {
+	writeLine(args.data(), args.size(), true, sev, file.c_str(), line, monotonicNs(), threadId());
+}
+
+
+void JsonLinesOutput::writeLine(const char * data_, size_t size_, bool binary_, Severity_t sev_, const char * file_, int line_, int64_t timestamp_, uint32_t thread_) const {
+	// Line is formatted in a buffer of the thread - reused, so in steady state no memory is allocated.
+	static thread_local std::string out;
+	char num[number_length];
+	char time[timestamp_length];
+
+	out.assign("{\"time\":\"");
+	out.append(time, formatTimestamp(timestamp_, time));
+	out += "\",\"mono_ns\":";
+	out.append(num, formatSigned(timestamp_, num));
+	out += ",\"thread\":";
+	out.append(num, formatUnsigned(thread_, num));
+	out += ",\"level\":\"";
+	out += sev2str(sev_);
+	out += "\",\"file\":";
+	appendString(out, file_, std::strlen(file_));
+	out += ",\"line\":";
+	out.append(num, formatSigned(line_, num));
+
+	if (binary_ && binary::isStructured(data_, size_)) {
+		if (!appendFields(out, data_, size_))
+			out += ",\"corrupted\":true";
+	} else if (binary_) {
+		// Plain binary arguments - formatted as the text message.
+		std::ostringstream os;
+		bool ok = binary::formatArguments(data_, size_, os);
+		std::string msg = os.str();
+		out += ",\"msg\":";
+		appendString(out, msg.data(), msg.size());
+		if (!ok)
+			out += ",\"corrupted\":true";
+	} else {
+		out += ",\"msg\":";
+		appendString(out, data_, size_);
+	}//: else
+	out += "}\n";
+
+	appendLine(out.data(), out.size(), sev_);
+}
+
+
+void JsonLinesOutput::appendString(std::string & out_, const char * str_, size_t len_) {
+	static const char hex[] = "0123456789abcdef";
+	out_ += '"';
+	const char * end = str_ + len_;
+	while (str_ < end) {
+		// Copy the run of characters that need no escaping at once.
+		const char * run = str_;
+		while ((str_ < end) && ((unsigned char)*str_ >= 0x20) && (*str_ != '"') && (*str_ != '\\'))
+			str_++;
+		out_.append(run, str_ - run);
+		if (str_ == end)
+			break;
+		char c = *str_++;
+		switch (c) {
+		case '"': out_ += "\\\""; break;
+		case '\\': out_ += "\\\\"; break;
+		case '\n': out_ += "\\n"; break;
+		case '\r': out_ += "\\r"; break;
+		case '\t': out_ += "\\t"; break;
+		default:
+			out_ += "\\u00";
+			out_ += hex[((unsigned char)c) >> 4];
+			out_ += hex[((unsigned char)c) & 0xf];
+		}//: switch
+	}//: while
+	out_ += '"';
+}
+
+
+bool JsonLinesOutput::appendFields(std::string & out_, const char * data_, size_t size_) {
+	const char * end = data_ + size_;
+	char num[number_length];
+	// Flag denoting that the key was appended and its value is expected.
+	bool after_key = false;
+	// Flag denoting that the "fields" object was opened.
+	bool in_fields = false;
+	bool ok = true;
+	while (ok && (data_ < end)) {
+		char tag = *data_++;
+		// Every value must be preceded by the key.
+		if (!after_key && (tag != binary::KeyArg) && (tag != binary::EventArg))
+			break;
+		switch (tag) {
+		case binary::EventArg:
+		case binary::KeyArg:
+		case binary::StringArg: {
+			uint32_t len;
+			if (!binary::readRaw(data_, end, len) || ((size_t)(end - data_) < len)) {
+				ok = false;
+				break;
+			}//: if
+			if (tag == binary::EventArg)
+				out_ += ",\"event\":";
+			else if (tag == binary::KeyArg) {
+				// User keys are nested, so they cannot collide with the keys of the record (level, msg, file...).
+				out_ += in_fields ? "," : ",\"fields\":{";
+				in_fields = true;
+			}//: else
+			appendString(out_, data_, len);
+			if (tag == binary::KeyArg)
+				out_ += ':';
+			data_ += len;
+			break;
+		}
+		case binary::SignedArg: {
+			int64_t val;
+			if ((ok = binary::readRaw(data_, end, val)))
+				out_.append(num, formatSigned(val, num));
+			break;
+		}
+		case binary::UnsignedArg: {
+			uint64_t val;
+			if ((ok = binary::readRaw(data_, end, val)))
+				out_.append(num, formatUnsigned(val, num));
+			break;
+		}
+		case binary::DoubleArg: {
+			double val;
+			if ((ok = binary::readRaw(data_, end, val))) {
+				if (std::isfinite(val))
+					out_.append(num, formatDouble(val, num));
+				else
+					out_ += "null";
+			}//: if
+			break;
+		}
+		case binary::BoolArg: {
+			uint8_t val;
+			if ((ok = binary::readRaw(data_, end, val)))
+				out_ += val ? "true" : "false";
+			break;
+		}
+		case binary::CharArg: {
+			uint8_t val;
+			if ((ok = binary::readRaw(data_, end, val))) {
+				char c = (char)val;
+				appendString(out_, &c, 1);
+			}//: if
+			break;
+		}
+		case binary::PointerArg: {
+			uint64_t val;
+			if ((ok = binary::readRaw(data_, end, val))) {
+				char hex[24];
+				int len = std::snprintf(hex, sizeof(hex), "\"0x%llx\"", (unsigned long long)val);
+				out_.append(hex, len);
+			}//: if
+			break;
+		}
+		default:
+			ok = false;
+		}//: switch
+		if (ok)
+			after_key = (tag == binary::KeyArg);
+	}//: while
+
+	// Keep the JSON valid - the key without value gets null.
+	if (after_key)
+		out_ += "null";
+	if (in_fields)
+		out_ += '}';
+	return ok && !after_key && (data_ == end);
+}
+
+} /* namespace logger */
+} /* namespace mic */
@@ -0,0 +1,104 @@
+/*!
+ * Copyright (C) tkornuta, IBM Corporation 2015-2019
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+/*!
+ * \file JsonLinesOutput.hpp
+ * \brief Contains declaration of the JsonLinesOutput class, writing log records as JSON objects (one per line).
+ * \author tkornuta
+ * \date Oct 17, 2026
+ */
+
+#ifndef SRC_LOGGER_JSONLINESOUTPUT_HPP_
+#define SRC_LOGGER_JSONLINESOUTPUT_HPP_
+
+#include <logger/FileOutput.hpp>
+
+#include <string>
+
+namespace mic {
+namespace logger {
+
+/*!
+ * \brief Output writing every record as a single-line JSON object, e.g.
+ * {"time":"2026-10-17 12:00:00.125","mono_ns":123,"thread":1,"level":"INFO","file":"Application.cpp","line":42,"event":"step_done","fields":{"iter":5,"loss":0.25}}
+ * Structured records (see LOG_KV) have the "event" and the "fields" object with their typed fields (so the user keys cannot collide
+ * with the keys of the record), other records the "msg" text.
+ * Numbers are written by the fast formatters (see NumberFormat.hpp), not-finite floating point values as null.
+ * Buffering, rotation and fsync are inherited from FileOutput.
+ * \author tkornuta
+ */
+class JsonLinesOutput : public FileOutput {
+public:
+	/*!
+	 * Constructor. Opens (appends to) the file.
+	 * @param filename_ Name of the file.
+	 * @param sev_ Output severity level (LINFO as default).
+	 * @param buffer_size_ Size of the user-space buffer.
+	 */
+	JsonLinesOutput(const std::string & filename_, Severity_t sev_ = LINFO, size_t buffer_size_ = 1 << 20);
+
+	/*!
+	 * Writes the record.
+	 * @param rec_ Record.
+	 * @param site_ Call site of the record.
+	 */
+	void write(const LogRecord & rec_, const LogSite & site_) const;
+
+	/*!
+	 * Writes the message.
+	 * @param msg Message to be printed.
+	 * @param sev Severity level.
+	 * @param file File that called the log function.
+	 * @param line Line in which log function was called.
+	 */
+	void print(const std::string & msg, Severity_t sev, const std::string & file, int line) const;
+
+	/*!
+	 * Writes the message with binary arguments (or the structured record).
+	 * @param args Binary arguments.
+	 * @param sev Severity level.
+	 * @param file File that called the log function.
+	 * @param line Line in which log function was called.
+	 */
+	void printBinary(const std::string & args, Severity_t sev, const std::string & file, int line) const;
+
+	/*!
+	 * Appends the string as a JSON string literal (quoted and escaped).
+	 * @param out_ Output.
+	 * @param str_ String.
+	 * @param len_ Length of the string.
+	 */
+	static void appendString(std::string & out_, const char * str_, size_t len_);
+
+	/*!
+	 * Appends the event and the fields of the structured record, e.g. ,"event":"step_done","fields":{"iter":5}
+	 * @param out_ Output.
+	 * @param data_ Binary arguments of the record.
+	 * @param size_ Size of the arguments.
+	 * @return False if the arguments are corrupted (the fields read so far are appended).
+	 */
+	static bool appendFields(std::string & out_, const char * data_, size_t size_);
+
+private:
+	/*!
+	 * Formats the JSON line and puts it into the buffer.
+	 */
+	void writeLine(const char * data_, size_t size_, bool binary_, Severity_t sev_, const char * file_, int line_, int64_t timestamp_, uint32_t thread_) const;
+};
+
+} /* namespace logger */
+} /* namespace mic */
+
+#endif /* SRC_LOGGER_JSONLINESOUTPUT_HPP_ */
@@ -26,6 +26,10 @@
 
 
 #include <logger/ScopeLogger.hpp>
+#include <logger/BinaryScopeLogger.hpp>
+#include <logger/LogSampler.hpp>
+#include <logger/LogFormat.hpp>
+#include <logger/LogCheck.hpp>
 
 /*!
  * \brief Macro returning logger instance.
@@ -33,22 +37,178 @@
  */
 #define LOGGER mic::logger::Logger::getInstance()
 
+/*!
+ * \brief Macro setting the logging category of all LOG statements in the enclosing namespace of the current file, e.g.
+ * MIC_LOG_CATEGORY("mic.configuration.ParameterServer"). Must be used inside a namespace (it hides the global mic_log_category()).
+ */
+#define MIC_LOG_CATEGORY(name) \
+	namespace { \
+		inline const mic::logger::LogCategory & mic_log_category() { \
+			static const mic::logger::LogCategory & category = mic::logger::LogCategory::get(name); \
+			return category; } \
+	}
+
+/*!
+ * \brief Macro returning the descriptor of the call site - a static LogSite registered when the statement is executed for the first time.
+ * The file name is reduced to its basename at compile time, the function name is passed to the lambda from the enclosing function.
+ * The category is returned by the mic_log_category() function visible at the place of the statement (see MIC_LOG_CATEGORY).
+ */
+#define MIC_LOG_SITE(level) \
+	[](const char * mic_log_function, mic::logger::Severity_t mic_log_severity) -> const mic::logger::LogSite& { \
+		static constexpr const char * mic_log_file = mic::logger::baseName(__FILE__); \
+		static const mic::logger::LogSite site(mic_log_file, __LINE__, mic_log_severity, mic_log_function, mic_log_category()); \
+		return site; }(__func__, level)
+
+/*!
+ * \brief Auxiliary macro executing the following statement (with mic_log_site pointing to the call site) when the site logs messages of a given level.
+ * The check costs a single relaxed load of the threshold cached in the site (set from the levels of outputs and the dynamic debug rules).
+ * The for statement (executed at most once) keeps the macro a single statement, so it can be used e.g. in if-else without braces.
+ */
+#define MIC_LOG_IF_ENABLED(level) \
+	for (const mic::logger::LogSite * mic_log_site = MIC_LOG_COMPILED_IN(level) ? &MIC_LOG_SITE(level) : NULL; \
+		mic_log_site && mic_log_site->isEnabled(level); mic_log_site = NULL)
+
 /*!
  * \brief Macro for message printing.
+ * When the message is not logged (no output accepts messages of a given level or the site is disabled) the stream arguments are not evaluated at all.
+ * Messages below MIC_LOG_COMPILE_LEVEL are removed at compile time.
+ */
+#define LOG(level) MIC_LOG_IF_ENABLED(level) \
+	mic::logger::ScopeLogger(LOGGER, *mic_log_site, level).get()
+
+/*!
+ * \brief Macro for message printing with deferred formatting - arguments are captured in binary form.
+ * The arguments are formatted only by the outputs that print text (binary outputs store them as they are).
+ */
+#define BLOG(level) MIC_LOG_IF_ENABLED(level) \
+	mic::logger::BinaryScopeLogger(LOGGER, *mic_log_site, level).get()
+
+/*!
+ * \brief Macro for formatted logging with "{}" placeholders, e.g. LOGF(LINFO, "iter {} loss {:.4f}", i, loss) (see mic::logger::format).
+ * The format string must be a literal - it is validated at compile time, as is the number of arguments.
+ * Numbers are formatted without streams, directly into the thread-local buffer.
+ */
+#define LOGF(level, fmt, ...) MIC_LOG_IF_ENABLED(level) \
+	mic::logger::logFormatted<mic::logger::format::placeholders(fmt), sizeof(mic::logger::format::argCounter(__VA_ARGS__)) - 1>( \
+		LOGGER, *mic_log_site, level, fmt, ##__VA_ARGS__)
+
+/*!
+ * \brief Macro for structured logging - the event name followed by key-value pairs, e.g. LOG_KV(LINFO, "step_done", "iter", iteration, "loss", loss).
+ * Values are captured as typed binary arguments (see BLOG), text outputs print them as "step_done iter=5 loss=0.25",
+ * JsonLinesOutput writes them as members of the "fields" object of the record.
+ */
+#define LOG_KV(level, ...) MIC_LOG_IF_ENABLED(level) \
+	mic::logger::BinaryScopeLogger(LOGGER, *mic_log_site, level).kv(__VA_ARGS__)
+
+/*!
+ * \brief Auxiliary macro used by the sampling macros - logs the message when the sampler of the call site lets it through.
+ * Every expansion defines its own static LogSampler (in a lambda), the sampler is consulted only when the site is enabled.
+ * The number of messages suppressed since the last logged one is appended to the message.
+ */
+#define MIC_LOG_SAMPLED(level, call) MIC_LOG_IF_ENABLED(level) \
+	for (uint64_t mic_log_suppressed = []() -> mic::logger::LogSampler& { static mic::logger::LogSampler sampler; return sampler; }().call; \
+		mic_log_suppressed != mic::logger::LogSampler::Suppressed; mic_log_suppressed = mic::logger::LogSampler::Suppressed) \
+		mic::logger::ScopeLogger(LOGGER, *mic_log_site, level, mic_log_suppressed).get()
+
+/*!
+ * \brief Macro logging every n-th occurrence of the message (1st, (n+1)th, ...).
+ */
+#define LOG_EVERY_N(level, n) MIC_LOG_SAMPLED(level, everyN(n))
+
+/*!
+ * \brief Macro logging only the first n occurrences of the message.
  */
-#define LOG(level) (mic::logger::ScopeLogger(LOGGER, __FILE__, __LINE__, level).get())
+#define LOG_FIRST_N(level, n) MIC_LOG_SAMPLED(level, firstN(n))
 
 /*!
- * \brief Macro for checking conditions.
+ * \brief Macro logging the message at most once per given number of milliseconds.
+ */
+#define LOG_EVERY_T(level, ms) MIC_LOG_SAMPLED(level, everyT(ms))
+
+/*!
+ * \brief Macro logging the message at most rate times per second on average (token bucket), allowing bursts of burst messages.
+ */
+#define LOG_RATE_LIMITED(level, rate, burst) MIC_LOG_SAMPLED(level, rateLimited(rate, burst))
+
+/*!
+ * \brief Macro returning the static CheckSite of the statement (see MIC_LOG_SITE).
+ */
+#define MIC_CHECK_SITE() \
+	[](const char * mic_log_function) -> mic::logger::CheckSite& { \
+		static constexpr const char * mic_log_file = mic::logger::baseName(__FILE__); \
+		static mic::logger::CheckSite site(mic_log_file, __LINE__, mic_log_function, mic_log_category()); \
+		return site; }(__func__)
+
+/*!
+ * \brief Auxiliary expression logging the failure of the check as LWARNING, e.g. "Check failed: x > 0" (stream arguments can follow).
+ * Failures are counted by the static CheckSite of the statement - only the 1st, 2nd, 4th, 8th, ... one is logged, with the number of failures so far.
+ */
+#define MIC_CHECK_FAILED(text) \
+	!(MIC_LOG_COMPILED_IN(LWARNING) && MIC_CHECK_SITE().fail()) ? (void)0 : mic::logger::CheckVoidify() & mic::logger::CheckLogger(text).get()
+
+/*!
+ * \brief Macro for checking conditions - logs LWARNING when the condition is false, e.g. CHECK(x > 0) << "x = " << x.
+ * The expression is evaluated exactly once, stream arguments only on (logged) failure.
+ * The macro is a single expression (as in glog), so it can be used in unbraced if-else statements or e.g. in comma expressions.
  * \author krocki
  */
-#define CHECK(EXP) mic::logger::check(EXP, #EXP, __LINE__, __FILE__)
+#define CHECK(EXP) \
+	MIC_LIKELY(EXP) ? (void)0 : MIC_CHECK_FAILED(#EXP)
+
+/*!
+ * \brief Auxiliary macro comparing two operands (each evaluated exactly once), the failure message contains their values.
+ */
+#define MIC_CHECK_OP(name, op, a, b) \
+	for (std::unique_ptr<std::string> mic_check_message = mic::logger::check##name##Impl((a), (b), #a " " #op " " #b); \
+		MIC_UNLIKELY(mic_check_message); mic_check_message.reset()) \
+		MIC_CHECK_FAILED(*mic_check_message)
+
+/*!
+ * \brief Macros comparing two operands, e.g. CHECK_EQ(rows, 3) logs "Check failed: rows == 3 (4 vs. 3)" when rows is 4.
+ * The operands must be printable with operator<<.
+ */
+#define CHECK_EQ(a, b) MIC_CHECK_OP(EQ, ==, a, b)
+#define CHECK_NE(a, b) MIC_CHECK_OP(NE, !=, a, b)
+#define CHECK_LT(a, b) MIC_CHECK_OP(LT, <, a, b)
+#define CHECK_LE(a, b) MIC_CHECK_OP(LE, <=, a, b)
+#define CHECK_GT(a, b) MIC_CHECK_OP(GT, >, a, b)
+#define CHECK_GE(a, b) MIC_CHECK_OP(GE, >=, a, b)
+
+/*!
+ * \brief Debug-only variants of the CHECK macros. In release builds (NDEBUG, see MIC_DCHECK_IS_ON) the statements are still compiled
+ * (so they do not rot) but never executed, so the expressions are not evaluated and the optimizer removes them completely.
+ */
+#if MIC_DCHECK_IS_ON
+#define DCHECK(EXP) CHECK(EXP)
+#define DCHECK_EQ(a, b) CHECK_EQ(a, b)
+#define DCHECK_NE(a, b) CHECK_NE(a, b)
+#define DCHECK_LT(a, b) CHECK_LT(a, b)
+#define DCHECK_LE(a, b) CHECK_LE(a, b)
+#define DCHECK_GT(a, b) CHECK_GT(a, b)
+#define DCHECK_GE(a, b) CHECK_GE(a, b)
+#else
+#define DCHECK(EXP) while (false) CHECK(EXP)
+#define DCHECK_EQ(a, b) while (false) CHECK_EQ(a, b)
+#define DCHECK_NE(a, b) while (false) CHECK_NE(a, b)
+#define DCHECK_LT(a, b) while (false) CHECK_LT(a, b)
+#define DCHECK_LE(a, b) while (false) CHECK_LE(a, b)
+#define DCHECK_GT(a, b) while (false) CHECK_GT(a, b)
+#define DCHECK_GE(a, b) while (false) CHECK_GE(a, b)
+#endif
+
+/*!
+ * \brief Returns the logging category of statements that have no category set (the root one).
+ * \author tkornuta
+ */
+inline const mic::logger::LogCategory & mic_log_category() {
+	return mic::logger::LogCategory::root();
+}
 
 namespace mic {
 namespace logger {
 
 /*!
- * \brief Function checking whether condition is true - if not, logs LWARNING.
+ * \brief Function checking whether condition is true - if not, logs LWARNING (every failure, unlike the CHECK macro).
  * \author krocki
  */
 static __inline__ void check(bool condition, const char* expression, int line, const char* file) {
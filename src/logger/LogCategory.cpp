@@ -0,0 +1,158 @@
+/*!
+ * Copyright (C) tkornuta, IBM Corporation 2015-2019
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+/*!
+ * \file LogCategory.cpp
+ * \brief Contains definitions of methods of the logging categories.
+ * \author tkornuta
+ * \date Oct 17, 2026
+ */
+
+#include <logger/LogCategory.hpp>
+#include <logger/LogSite.hpp>
+
+#include <boost/thread/mutex.hpp>
+
+#include <map>
+
+namespace mic {
+namespace logger {
+
+const int LogCategory::no_level;
+
+/*!
+ * \brief State of the categories.
+ */
+struct LogCategory::State {
+	/// Mutex protecting the categories.
+	boost::mutex mutex;
+
+	/// Root category.
+	LogCategory root;
+
+	/// All categories, sorted by name - so parents precede their children.
+	std::map<std::string, LogCategory*> categories;
+
+	State() : root("", NULL) {
+		categories[""] = &root;
+	}
+};
+
+
+LogCategory::LogCategory(const std::string & name_, LogCategory * parent_) :
+	name(name_), parent(parent_), level(no_level),
+	threshold(parent_ ? parent_->getThreshold() : no_level)
+{
+
+}
+
+
+LogCategory::State & LogCategory::state() {
+	// Never destroyed - sites can refer to categories until the very end of the program.
+	static State * s = new State();
+	return *s;
+}
+
+
+LogCategory & LogCategory::root() {
+	return state().root;
+}
+
+
+LogCategory & LogCategory::get(const std::string & name_) {
+	State & s = state();
+	boost::mutex::scoped_lock lock(s.mutex);
+	std::map<std::string, LogCategory*>::iterator it = s.categories.find(name_);
+	if (it != s.categories.end())
+		return *it->second;
+
+	// Create the missing ancestors - from the top.
+	LogCategory * parent = &s.root;
+	size_t pos = 0;
+	for (;;) {
+		size_t dot = name_.find('.', pos);
+		std::string prefix = name_.substr(0, dot);
+		it = s.categories.find(prefix);
+		if (it == s.categories.end())
+			it = s.categories.insert(std::make_pair(prefix, new LogCategory(prefix, parent))).first;
+		parent = it->second;
+		if (dot == std::string::npos)
+			break;
+		pos = dot + 1;
+	}//: for
+	return *parent;
+}
+
+
+void LogCategory::setLevel(Severity_t sev_) {
+	changeLevel(sev_);
+}
+
+
+void LogCategory::resetLevel() {
+	changeLevel(no_level);
+}
+
+
+void LogCategory::changeLevel(int level_) {
+	{
+		State & s = state();
+		boost::mutex::scoped_lock lock(s.mutex);
+		level = level_;
+		// Parents precede their children, so a single pass is enough.
+		for (std::map<std::string, LogCategory*>::iterator it = s.categories.begin(); it != s.categories.end(); ++it) {
+			LogCategory * cat = it->second;
+			int th = cat->level;
+			if ((th == no_level) && cat->parent)
+				th = cat->parent->getThreshold();
+			cat->threshold.store(th, boost::memory_order_relaxed);
+		}//: for
+	}
+	// Resolve the thresholds of sites.
+	LogSiteRegistry::updateSites();
+}
+
+
+bool LogCategory::setLevels(const std::string & levels_) {
+	bool ok = true;
+	size_t pos = 0;
+	while (pos < levels_.size()) {
+		size_t end = levels_.find_first_of(" \t,;", pos);
+		if (end == std::string::npos)
+			end = levels_.size();
+		std::string token = levels_.substr(pos, end - pos);
+		pos = end + 1;
+		if (token.empty())
+			continue;
+
+		size_t eq = token.find('=');
+		if (eq == std::string::npos) {
+			ok = false;
+			continue;
+		}//: if
+		std::string lvl = token.substr(eq + 1);
+		Severity_t sev;
+		if (lvl.empty() || (lvl == "INHERIT") || (lvl == "inherit"))
+			get(token.substr(0, eq)).resetLevel();
+		else if (str2sev(lvl, sev))
+			get(token.substr(0, eq)).setLevel(sev);
+		else
+			ok = false;
+	}//: while
+	return ok;
+}
+
+} /* namespace logger */
+} /* namespace mic */
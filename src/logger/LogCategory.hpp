@@ -0,0 +1,142 @@
+/*!
+ * Copyright (C) tkornuta, IBM Corporation 2015-2019
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+/*!
+ * \file LogCategory.hpp
+ * \brief Contains declaration of hierarchical logging categories.
+ * \author tkornuta
+ * \date Oct 17, 2026
+ */
+
+#ifndef SRC_LOGGER_LOGCATEGORY_HPP_
+#define SRC_LOGGER_LOGCATEGORY_HPP_
+
+#include <logger/LoggerAux.hpp>
+
+#include <boost/atomic.hpp>
+
+#include <string>
+
+namespace mic {
+namespace logger {
+
+/*!
+ * \class LogCategory
+ * \brief Named logging category (e.g. "mic.configuration.ParameterServer"), forming a hierarchy by dot-separated names.
+ * A category can have its own severity level - otherwise it inherits the level of its closest ancestor having one.
+ * When a category (or its ancestor) has a level, messages of its sites are filtered by this level instead of the minimal level of outputs -
+ * outputs still apply their own levels, unless they accept forced records (see LoggerOutput::setForcedRecords(), enabled by ConsoleOutput).
+ * So a category can be made more verbose than an output only on outputs accepting forced records - on the others it can only be made quieter.
+ * Otherwise they are filtered by the levels of outputs.
+ * The level is resolved into the threshold cached in every log site (see LogSite), so the check still costs a single load.
+ * \author tkornuta
+ */
+class LogCategory {
+public:
+	/// Value of the threshold denoting that neither the category nor its ancestors have a level.
+	static const int no_level = -1;
+
+	/*!
+	 * Returns the category with given name - creates it (and its ancestors) if it does not exist.
+	 * @param name_ Dot-separated name of the category (empty - the root category).
+	 */
+	static LogCategory & get(const std::string & name_);
+
+	/*!
+	 * Returns the root category (used by the sites with no category set).
+	 */
+	static LogCategory & root();
+
+	/*!
+	 * Sets levels of categories.
+	 * @param levels_ List of category=LEVEL pairs, separated by spaces, commas or semicolons (e.g. "mic.configuration=WARNING my.learner=DEBUG").
+	 * Level "INHERIT" (or empty) removes the level of the category.
+	 * @return False if any of the pairs was invalid (valid pairs are applied).
+	 */
+	static bool setLevels(const std::string & levels_);
+
+	/*!
+	 * Returns the name of the category.
+	 */
+	const std::string & getName() const {
+		return name;
+	}
+
+	/*!
+	 * Returns the parent category (NULL for root).
+	 */
+	const LogCategory * getParent() const {
+		return parent;
+	}
+
+	/*!
+	 * Sets the level of the category (and of its descendants that have no level of their own).
+	 * @param sev_ Level.
+	 */
+	void setLevel(Severity_t sev_);
+
+	/*!
+	 * Removes the level of the category - it will inherit the level of its parent.
+	 */
+	void resetLevel();
+
+	/*!
+	 * Returns the effective threshold of the category (its level, level inherited from the closest ancestor having one, or no_level).
+	 */
+	int getThreshold() const {
+		return threshold.load(boost::memory_order_relaxed);
+	}
+
+private:
+	/*!
+	 * Constructor.
+	 * @param name_ Name.
+	 * @param parent_ Parent category.
+	 */
+	LogCategory(const std::string & name_, LogCategory * parent_);
+
+	LogCategory(const LogCategory &);
+	LogCategory& operator =(const LogCategory&);
+
+	/*!
+	 * Sets the level of the category (no_level - inherit) and updates the thresholds of all categories and sites.
+	 */
+	void changeLevel(int level_);
+
+	/// State of the categories.
+	struct State;
+
+	/*!
+	 * Returns the state of the categories (created on first use).
+	 */
+	static State & state();
+
+	/// Name.
+	const std::string name;
+
+	/// Parent category.
+	LogCategory * parent;
+
+	/// Own level of the category (no_level - inherited).
+	int level;
+
+	/// Effective threshold.
+	boost::atomic<int> threshold;
+};
+
+} /* namespace logger */
+} /* namespace mic */
+
+#endif /* SRC_LOGGER_LOGCATEGORY_HPP_ */
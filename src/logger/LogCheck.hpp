@@ -0,0 +1,219 @@
+/*!
+ * Copyright (C) tkornuta, IBM Corporation 2015-2019
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+/*!
+ * \file LogCheck.hpp
+ * \brief Contains the helpers of the CHECK/DCHECK macros - branch hints, per-site failure counters and formatting of compared operands.
+ * \author tkornuta
+ * \date Oct 17, 2026
+ */
+
+#ifndef SRC_LOGGER_LOGCHECK_HPP_
+#define SRC_LOGGER_LOGCHECK_HPP_
+
+#include <logger/ScopeLogger.hpp>
+
+#include <boost/atomic.hpp>
+#include <boost/cstdint.hpp>
+
+#include <memory>
+#include <sstream>
+#include <string>
+
+/*!
+ * \brief Branch hints - tell the compiler which outcome of the condition is expected.
+ */
+#if defined(__GNUC__) || defined(__clang__)
+#define MIC_LIKELY(x) (__builtin_expect(!!(x), 1))
+#define MIC_UNLIKELY(x) (__builtin_expect(!!(x), 0))
+#else
+#define MIC_LIKELY(x) (!!(x))
+#define MIC_UNLIKELY(x) (!!(x))
+#endif
+
+/*!
+ * \brief Flag denoting whether the DCHECK macros are compiled in - by default in debug builds only (when NDEBUG is not defined).
+ */
+#ifndef MIC_DCHECK_IS_ON
+#ifdef NDEBUG
+#define MIC_DCHECK_IS_ON 0
+#else
+#define MIC_DCHECK_IS_ON 1
+#endif
+#endif
+
+namespace mic {
+namespace logger {
+
+/*!
+ * \brief Failure of a check being logged - passed from CheckSite::fail() to the CheckLogger created by the same statement.
+ */
+struct CheckFailure {
+	/// Call site of the check.
+	const LogSite * site;
+
+	/// Number of failures so far.
+	uint64_t failures;
+
+	CheckFailure() : site(NULL), failures(0) { }
+};
+
+
+/*!
+ * \class CheckSite
+ * \brief Call site and failure counter of a single CHECK statement - every statement has its own static instance.
+ * Only the 1st, 2nd, 4th, 8th, ... failure is logged (with the number of failures so far), the others are just counted.
+ * \author tkornuta
+ */
+class CheckSite {
+public:
+	/*!
+	 * Constructor. Registers the (LWARNING) log site of the check.
+	 * @param file_ Name of the file.
+	 * @param line_ Line.
+	 * @param function_ Name of the function.
+	 * @param category_ Logging category.
+	 */
+	CheckSite(const char * file_, int line_, const char * function_, const LogCategory & category_) :
+		site(file_, line_, Warning, function_, category_), failures(0) { }
+
+	/*!
+	 * Counts the failure and stores it as the current failure of the thread (see current()) when it should be logged.
+	 * @return True if the failure should be logged - it is the 1st, 2nd, 4th, ... one and the warnings of the site are enabled
+	 * (whether they are compiled in is checked by the CHECK macro).
+	 */
+	bool fail() {
+		uint64_t n = failures.fetch_add(1, boost::memory_order_relaxed) + 1;
+		if (((n & (n - 1)) != 0) || !site.isEnabled(Warning))
+			return false;
+		current().site = &site;
+		current().failures = n;
+		return true;
+	}
+
+	/*!
+	 * Returns the failure being logged by the current thread.
+	 */
+	static CheckFailure & current() {
+		static thread_local CheckFailure failure;
+		return failure;
+	}
+
+private:
+	/// Log site of the check.
+	LogSite site;
+
+	/// Number of failures.
+	boost::atomic<uint64_t> failures;
+};
+
+
+/*!
+ * \brief Number of failures of the check, appended to the logged failure message (when greater than one).
+ */
+struct CheckFailures {
+	/// Number of failures.
+	uint64_t count;
+
+	explicit CheckFailures(uint64_t count_) : count(count_) { }
+};
+
+/*!
+ * Prints the number of failures, e.g. " [failed 4 times]".
+ */
+inline std::ostream & operator<<(std::ostream & os_, const CheckFailures & failures_) {
+	if (failures_.count > 1)
+		os_ << " [failed " << failures_.count << " times]";
+	return os_;
+}
+
+
+/*!
+ * \class CheckLogger
+ * \brief Logger of the failed check - created only when CheckSite::fail() returned true, logs the message when destroyed
+ * (at the end of the full expression), e.g. "Check failed: x > 0 [failed 4 times]" followed by the stream arguments.
+ * \author tkornuta
+ */
+class CheckLogger {
+public:
+	/*!
+	 * Constructor. Starts the message of the current failure (see CheckSite::current()).
+	 * @param text_ Text of the check.
+	 */
+	explicit CheckLogger(const std::string & text_) :
+		logger(Logger::getInstance(), *CheckSite::current().site, Warning)
+	{
+		logger.get() << "Check failed: " << text_ << CheckFailures(CheckSite::current().failures);
+	}
+
+	/*!
+	 * Returns the stream for the arguments of the message.
+	 */
+	std::ostream & get() {
+		return logger.get();
+	}
+
+private:
+	/// Logger of the message.
+	ScopeLogger logger;
+};
+
+
+/*!
+ * \brief Turns the stream of the failed check into void - so both branches of the conditional operator of CHECK have the same type.
+ * The operator & has lower precedence than << and higher than ?:, so the stream arguments bind to the stream.
+ */
+struct CheckVoidify {
+	void operator&(std::ostream &) { }
+};
+
+
+/*!
+ * Formats the message of the failed comparison, e.g. "a == b (3 vs. 4)" - called on failure only.
+ * @param a_ First operand.
+ * @param b_ Second operand.
+ * @param text_ Text of the comparison.
+ */
+template <typename A, typename B>
+std::unique_ptr<std::string> checkOpMessage(const A & a_, const B & b_, const char * text_) {
+	std::ostringstream os;
+	os << text_ << " (" << a_ << " vs. " << b_ << ")";
+	return std::unique_ptr<std::string>(new std::string(os.str()));
+}
+
+/*!
+ * \brief Defines the function comparing the operands of CHECK_<name> - returns NULL on success and the message on failure.
+ */
+#define MIC_DEFINE_CHECK_OP(name, op) \
+	template <typename A, typename B> \
+	inline std::unique_ptr<std::string> check##name##Impl(const A & a_, const B & b_, const char * text_) { \
+		if (MIC_LIKELY(a_ op b_)) \
+			return std::unique_ptr<std::string>(); \
+		return checkOpMessage(a_, b_, text_); \
+	}
+
+MIC_DEFINE_CHECK_OP(EQ, ==)
+MIC_DEFINE_CHECK_OP(NE, !=)
+MIC_DEFINE_CHECK_OP(LT, <)
+MIC_DEFINE_CHECK_OP(LE, <=)
+MIC_DEFINE_CHECK_OP(GT, >)
+MIC_DEFINE_CHECK_OP(GE, >=)
+
+#undef MIC_DEFINE_CHECK_OP
+
+} /* namespace logger */
+} /* namespace mic */
+
+#endif /* SRC_LOGGER_LOGCHECK_HPP_ */
@@ -0,0 +1,71 @@
+/*!
+ * Copyright (C) tkornuta, IBM Corporation 2015-2019
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+/*!
+ * \file LogClock.cpp
+ * \brief Contains definitions of functions related to the timestamps and thread ids of log records.
+ * \author tkornuta
+ * \date Oct 17, 2026
+ */
+
+#include <logger/LogClock.hpp>
+
+#include <boost/atomic.hpp>
+
+#include <cstring>
+
+namespace mic {
+namespace logger {
+
+int64_t wallClockOffset() {
+	static const int64_t offset = std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::system_clock::now().time_since_epoch()).count() - monotonicNs();
+	return offset;
+}
+
+
+uint32_t nextThreadId() {
+	static boost::atomic<uint32_t> next_id(1);
+	return next_id.fetch_add(1, boost::memory_order_relaxed);
+}
+
+
+size_t formatWallClock(int64_t wall_ns_, char * buf_) {
+	// Prefix (date and time up to seconds) cached by the thread.
+	static thread_local int64_t cached_second = -1;
+	static thread_local char cached_prefix[timestamp_length];
+	static thread_local size_t cached_length = 0;
+
+	int64_t second = wall_ns_ / 1000000000;
+	int millis = (int)((wall_ns_ % 1000000000) / 1000000);
+	if (second != cached_second) {
+		time_t t = (time_t)second;
+		struct tm tm;
+		localtime_r(&t, &tm);
+		cached_length = std::strftime(cached_prefix, sizeof(cached_prefix), "%Y-%m-%d %H:%M:%S", &tm);
+		cached_second = second;
+	}//: if
+
+	std::memcpy(buf_, cached_prefix, cached_length);
+	char * p = buf_ + cached_length;
+	p[0] = '.';
+	p[1] = (char)('0' + millis / 100);
+	p[2] = (char)('0' + (millis / 10) % 10);
+	p[3] = (char)('0' + millis % 10);
+	p[4] = '\0';
+	return cached_length + 4;
+}
+
+} /* namespace logger */
+} /* namespace mic */
@@ -0,0 +1,94 @@
+/*!
+ * Copyright (C) tkornuta, IBM Corporation 2015-2019
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+/*!
+ * \file LogClock.hpp
+ * \brief Contains definitions of the cheap clock and thread ids stamped on every log record, and of the timestamp formatting.
+ * \author tkornuta
+ * \date Oct 17, 2026
+ */
+
+#ifndef SRC_LOGGER_LOGCLOCK_HPP_
+#define SRC_LOGGER_LOGCLOCK_HPP_
+
+#include <boost/cstdint.hpp>
+
+#include <chrono>
+#include <cstddef>
+#include <time.h>
+
+namespace mic {
+namespace logger {
+
+/*!
+ * Returns the monotonic time in nanoseconds, read from the cheapest clock source available.
+ * On Linux it is CLOCK_MONOTONIC_COARSE - read from the vDSO without a system call, with the resolution of the scheduler tick (1-4 ms).
+ */
+inline int64_t monotonicNs() {
+#if defined(CLOCK_MONOTONIC_COARSE)
+	struct timespec ts;
+	clock_gettime(CLOCK_MONOTONIC_COARSE, &ts);
+	return (int64_t)ts.tv_sec * 1000000000 + ts.tv_nsec;
+#else
+	return std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now().time_since_epoch()).count();
+#endif
+}
+
+/*!
+ * Returns the next free compact thread id.
+ */
+uint32_t nextThreadId();
+
+/*!
+ * Returns the compact id of the calling thread - small integers (1, 2, ...) assigned in the order in which threads log for the first time.
+ */
+inline uint32_t threadId() {
+	static thread_local uint32_t id = nextThreadId();
+	return id;
+}
+
+/*!
+ * Maximal length of the formatted timestamp (with the terminating zero).
+ */
+const size_t timestamp_length = 32;
+
+/*!
+ * Returns the difference between the wall-clock and the monotonic time in nanoseconds - measured once, at the first use.
+ */
+int64_t wallClockOffset();
+
+/*!
+ * Formats the wall-clock time as local time "YYYY-MM-DD HH:MM:SS.mmm".
+ * The part up to seconds is cached per thread and formatted only when the second changes, so in steady state only the milliseconds are formatted.
+ * @param wall_ns_ Wall-clock time in nanoseconds since the epoch.
+ * @param buf_ Output buffer of (at least) timestamp_length characters.
+ * @return Length of the formatted time.
+ */
+size_t formatWallClock(int64_t wall_ns_, char * buf_);
+
+/*!
+ * Formats the monotonic timestamp as local wall-clock time "YYYY-MM-DD HH:MM:SS.mmm" (see formatWallClock()).
+ * @param timestamp_ Monotonic timestamp (see monotonicNs()).
+ * @param buf_ Output buffer of (at least) timestamp_length characters.
+ * @return Length of the formatted timestamp.
+ */
+inline size_t formatTimestamp(int64_t timestamp_, char * buf_) {
+	return formatWallClock(timestamp_ + wallClockOffset(), buf_);
+}
+
+} /* namespace logger */
+} /* namespace mic */
+
+#endif /* SRC_LOGGER_LOGCLOCK_HPP_ */
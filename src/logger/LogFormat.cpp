@@ -0,0 +1,186 @@
+/*!
+ * Copyright (C) tkornuta, IBM Corporation 2015-2019
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+/*!
+ * \file LogFormat.cpp
+ * \brief Contains definitions of functions formatting the messages of LOGF.
+ * \author tkornuta
+ * \date Oct 17, 2026
+ */
+
+#include <logger/LogFormat.hpp>
+#include <logger/NumberFormat.hpp>
+
+#include <cstdio>
+#include <cstring>
+
+namespace mic {
+namespace logger {
+namespace format {
+
+bool nextSpec(std::string & out_, const char *& f_, Spec & spec_) {
+	for (;;) {
+		// Copy the run of plain characters at once.
+		const char * run = f_;
+		while ((*f_ != '\0') && (*f_ != '{') && (*f_ != '}'))
+			f_++;
+		out_.append(run, f_ - run);
+		if (*f_ == '\0')
+			return false;
+		if (f_[0] == f_[1]) {
+			// Escaped brace.
+			out_ += *f_;
+			f_ += 2;
+			continue;
+		}//: if
+		if (*f_ == '}') {
+			// Unmatched brace (rejected at compile time) - copy it.
+			out_ += *f_++;
+			continue;
+		}//: if
+		break;
+	}//: for
+
+	// Parse the placeholder {[:[width][.precision][type]]}.
+	f_++;
+	spec_.align = 0;
+	spec_.width = 0;
+	spec_.precision = -1;
+	spec_.type = 0;
+	if (*f_ == ':') {
+		f_++;
+		if ((*f_ == '<') || (*f_ == '>'))
+			spec_.align = *f_++;
+		while ((*f_ >= '0') && (*f_ <= '9'))
+			spec_.width = spec_.width * 10 + (*f_++ - '0');
+		if (*f_ == '.') {
+			f_++;
+			spec_.precision = 0;
+			while ((*f_ >= '0') && (*f_ <= '9'))
+				spec_.precision = spec_.precision * 10 + (*f_++ - '0');
+		}//: if
+		if ((*f_ != '}') && (*f_ != '\0'))
+			spec_.type = *f_++;
+	}//: if
+	if (*f_ == '}')
+		f_++;
+	return true;
+}
+
+
+void pad(std::string & out_, size_t start_, const Spec & spec_, bool right_) {
+	size_t len = out_.size() - start_;
+	if ((int)len >= spec_.width)
+		return;
+	if (spec_.align)
+		right_ = (spec_.align == '>');
+	if (right_)
+		out_.insert(start_, spec_.width - len, ' ');
+	else
+		out_.append(spec_.width - len, ' ');
+}
+
+
+void append(std::string & out_, const Spec & spec_, int64_t val_) {
+	if ((spec_.type == 'f') || (spec_.type == 'e') || (spec_.type == 'g')) {
+		append(out_, spec_, (double)val_);
+		return;
+	}//: if
+	if (spec_.type == 'x') {
+		append(out_, spec_, (uint64_t)val_);
+		return;
+	}//: if
+	size_t start = out_.size();
+	char buf[number_length];
+	out_.append(buf, formatSigned(val_, buf));
+	pad(out_, start, spec_, true);
+}
+
+
+void append(std::string & out_, const Spec & spec_, uint64_t val_) {
+	if ((spec_.type == 'f') || (spec_.type == 'e') || (spec_.type == 'g')) {
+		append(out_, spec_, (double)val_);
+		return;
+	}//: if
+	size_t start = out_.size();
+	char buf[number_length];
+	if (spec_.type == 'x')
+		out_.append(buf, std::snprintf(buf, sizeof(buf), "%llx", (unsigned long long)val_));
+	else
+		out_.append(buf, formatUnsigned(val_, buf));
+	pad(out_, start, spec_, true);
+}
+
+
+void append(std::string & out_, const Spec & spec_, double val_) {
+	size_t start = out_.size();
+	char buf[number_length];
+	int precision = (spec_.precision < 0) ? 6 : spec_.precision;
+	if (spec_.type == 'f')
+		out_.append(buf, formatFixed(val_, precision, buf));
+	else if ((spec_.type == 'e') || (spec_.type == 'g') || (spec_.precision >= 0)) {
+		int len = std::snprintf(buf, sizeof(buf), (spec_.type == 'e') ? "%.*e" : "%.*g", (precision > 17) ? 17 : precision, val_);
+		out_.append(buf, len);
+	} else
+		out_.append(buf, formatDouble(val_, buf));
+	pad(out_, start, spec_, true);
+}
+
+
+void append(std::string & out_, const Spec & spec_, bool val_) {
+	if (spec_.type == 'd') {
+		append(out_, spec_, (int64_t)val_);
+		return;
+	}//: if
+	append(out_, spec_, val_ ? "true" : "false", val_ ? 4 : 5);
+}
+
+
+void append(std::string & out_, const Spec & spec_, char val_) {
+	if ((spec_.type == 'd') || (spec_.type == 'x')) {
+		append(out_, spec_, (int64_t)val_);
+		return;
+	}//: if
+	append(out_, spec_, &val_, 1);
+}
+
+
+void append(std::string & out_, const Spec & spec_, const char * val_, size_t len_) {
+	size_t start = out_.size();
+	// Precision limits the length of the string.
+	if ((spec_.precision >= 0) && ((size_t)spec_.precision < len_))
+		len_ = spec_.precision;
+	out_.append(val_, len_);
+	pad(out_, start, spec_, false);
+}
+
+
+void append(std::string & out_, const Spec & spec_, const char * val_) {
+	if (!val_)
+		val_ = "(null)";
+	append(out_, spec_, val_, std::strlen(val_));
+}
+
+
+void append(std::string & out_, const Spec & spec_, const void * val_) {
+	size_t start = out_.size();
+	char buf[number_length];
+	out_.append(buf, std::snprintf(buf, sizeof(buf), "0x%llx", (unsigned long long)(uintptr_t)val_));
+	pad(out_, start, spec_, true);
+}
+
+} /* namespace format */
+} /* namespace logger */
+} /* namespace mic */
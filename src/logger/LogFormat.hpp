@@ -0,0 +1,308 @@
+/*!
+ * Copyright (C) tkornuta, IBM Corporation 2015-2019
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+/*!
+ * \file LogFormat.hpp
+ * \brief Contains the formatting of messages with "{}" placeholders (used by the LOGF macro), with format strings checked at compile time.
+ * \author tkornuta
+ * \date Oct 17, 2026
+ */
+
+#ifndef SRC_LOGGER_LOGFORMAT_HPP_
+#define SRC_LOGGER_LOGFORMAT_HPP_
+
+#include <logger/Logger.hpp>
+#include <logger/LogStream.hpp>
+
+#include <string>
+#include <type_traits>
+
+namespace mic {
+namespace logger {
+
+/*!
+ * \namespace mic::logger::format
+ * \brief Contains the functions parsing and applying the format strings of LOGF.
+ *
+ * Format string contains text and placeholders {} or {:[align][width][.precision][type]}, where align is < (left) or > (right) and type is one of:
+ * d (integer), x (hexadecimal integer), f (fixed), e (exponent), g (general) or s (string); {{ and }} denote the braces.
+ * Without type the values are formatted as by the fmt library - integers as decimal numbers, floating point numbers
+ * with the shortest representation that reads back as the same value, booleans as true/false.
+ * By default numbers are right-aligned and strings left-aligned within the width. Other types are formatted by operator<<.
+ * \author tkornuta
+ */
+namespace format {
+
+/*!
+ * Skips the decimal digits.
+ */
+constexpr const char * skipDigits(const char * f_) {
+	return ((*f_ >= '0') && (*f_ <= '9')) ? skipDigits(f_ + 1) : f_;
+}
+
+/*!
+ * Returns true if the character is a valid type of the placeholder.
+ */
+constexpr bool isType(char c_) {
+	return (c_ == 'd') || (c_ == 'x') || (c_ == 'f') || (c_ == 'e') || (c_ == 'g') || (c_ == 's');
+}
+
+/*!
+ * Returns the pointer after the closing brace of the placeholder (NULL if the brace is missing).
+ */
+constexpr const char * closeSpec(const char * f_) {
+	return (*f_ == '}') ? f_ + 1 : nullptr;
+}
+
+/*!
+ * Parses the precision and type of the placeholder.
+ */
+constexpr const char * precisionEnd(const char * f_) {
+	return (*f_ == '.') ?
+			(((f_[1] >= '0') && (f_[1] <= '9')) ? precisionEnd(skipDigits(f_ + 1)) : nullptr) :
+			closeSpec(isType(*f_) ? f_ + 1 : f_);
+}
+
+/*!
+ * Parses the alignment, width, precision and type of the placeholder.
+ */
+constexpr const char * alignEnd(const char * f_) {
+	return precisionEnd(skipDigits(((*f_ == '<') || (*f_ == '>')) ? f_ + 1 : f_));
+}
+
+/*!
+ * Returns the pointer after the placeholder (f_ points after the opening brace), NULL if the placeholder is invalid.
+ */
+constexpr const char * specEnd(const char * f_) {
+	return (*f_ == '}') ? f_ + 1 : ((*f_ == ':') ? alignEnd(f_ + 1) : nullptr);
+}
+
+/*!
+ * Returns the number of placeholders in the format string, or -1 if the format string is invalid.
+ * Evaluated at compile time for string literals (recursively - so the length of the literal is limited by the constexpr depth of the compiler).
+ * @param f_ Format string.
+ * @param n_ Number of placeholders found so far.
+ */
+constexpr int placeholders(const char * f_, int n_ = 0);
+
+/*!
+ * Continues counting after the placeholder.
+ */
+constexpr int placeholdersAfter(const char * f_, int n_) {
+	return f_ ? placeholders(f_, n_) : -1;
+}
+
+constexpr int placeholders(const char * f_, int n_) {
+	return (*f_ == '\0') ? n_ :
+			(*f_ == '{') ? ((f_[1] == '{') ? placeholders(f_ + 2, n_) : placeholdersAfter(specEnd(f_ + 1), n_ + 1)) :
+			(*f_ == '}') ? ((f_[1] == '}') ? placeholders(f_ + 2, n_) : -1) :
+			placeholders(f_ + 1, n_);
+}
+
+/*!
+ * Declaration used for counting of the arguments in unevaluated context: sizeof(argCounter(args...)) - 1.
+ */
+template <typename... Args>
+char (&argCounter(const Args&...))[sizeof...(Args) + 1];
+
+/*!
+ * \brief Parsed placeholder.
+ */
+struct Spec {
+	/// Alignment ('<', '>' or 0 - default).
+	char align;
+
+	/// Minimal width (0 - none).
+	int width;
+
+	/// Precision (-1 - default).
+	int precision;
+
+	/// Type (0 - default).
+	char type;
+};
+
+/*!
+ * Copies the text of the format string up to the next placeholder (replacing the escaped braces) and parses the placeholder.
+ * @param out_ Output.
+ * @param f_ Format string, moved after the placeholder.
+ * @param spec_ Parsed placeholder.
+ * @return False if there is no next placeholder.
+ */
+bool nextSpec(std::string & out_, const char *& f_, Spec & spec_);
+
+/*!
+ * Pads the value appended from given position to the width of the placeholder.
+ * @param out_ Output.
+ * @param start_ Position in the output at which the value starts.
+ * @param spec_ Placeholder.
+ * @param right_ True - align to the right.
+ */
+void pad(std::string & out_, size_t start_, const Spec & spec_, bool right_);
+
+/// Formats the signed integer.
+void append(std::string & out_, const Spec & spec_, int64_t val_);
+
+/// Formats the unsigned integer.
+void append(std::string & out_, const Spec & spec_, uint64_t val_);
+
+/// Formats the floating point number.
+void append(std::string & out_, const Spec & spec_, double val_);
+
+/// Formats the boolean.
+void append(std::string & out_, const Spec & spec_, bool val_);
+
+/// Formats the character.
+void append(std::string & out_, const Spec & spec_, char val_);
+
+/// Formats the string.
+void append(std::string & out_, const Spec & spec_, const char * val_, size_t len_);
+
+/// Formats the pointer.
+void append(std::string & out_, const Spec & spec_, const void * val_);
+
+/// Kinds of the arguments.
+typedef std::integral_constant<int, 0> OtherKind;
+typedef std::integral_constant<int, 1> SignedKind;
+typedef std::integral_constant<int, 2> UnsignedKind;
+typedef std::integral_constant<int, 3> FloatingKind;
+typedef std::integral_constant<int, 4> BoolKind;
+typedef std::integral_constant<int, 5> CharKind;
+typedef std::integral_constant<int, 6> PointerKind;
+typedef std::integral_constant<int, 7> CStringKind;
+typedef std::integral_constant<int, 8> StringKind;
+
+/*!
+ * Trait returning kind of the argument.
+ */
+template <typename T>
+struct ArgumentKind {
+	typedef typename std::decay<T>::type D;
+	typedef typename std::conditional<std::is_same<D, bool>::value, BoolKind,
+		typename std::conditional<std::is_same<D, char>::value, CharKind,
+		typename std::conditional<std::is_integral<D>::value && std::is_signed<D>::value, SignedKind,
+		typename std::conditional<std::is_integral<D>::value, UnsignedKind,
+		typename std::conditional<std::is_floating_point<D>::value, FloatingKind,
+		typename std::conditional<std::is_same<D, char*>::value || std::is_same<D, const char*>::value, CStringKind,
+		typename std::conditional<std::is_pointer<D>::value, PointerKind,
+		typename std::conditional<std::is_same<D, std::string>::value, StringKind,
+		OtherKind>::type>::type>::type>::type>::type>::type>::type>::type type;
+};
+
+template <typename T>
+void appendArg(LogStream *, std::string & out_, const Spec & spec_, const T & val_, SignedKind) {
+	append(out_, spec_, (int64_t)val_);
+}
+
+template <typename T>
+void appendArg(LogStream *, std::string & out_, const Spec & spec_, const T & val_, UnsignedKind) {
+	append(out_, spec_, (uint64_t)val_);
+}
+
+template <typename T>
+void appendArg(LogStream *, std::string & out_, const Spec & spec_, const T & val_, FloatingKind) {
+	append(out_, spec_, (double)val_);
+}
+
+template <typename T>
+void appendArg(LogStream *, std::string & out_, const Spec & spec_, const T & val_, BoolKind) {
+	append(out_, spec_, (bool)val_);
+}
+
+template <typename T>
+void appendArg(LogStream *, std::string & out_, const Spec & spec_, const T & val_, CharKind) {
+	append(out_, spec_, (char)val_);
+}
+
+/// Formats the C string (NULL as "(null)").
+void append(std::string & out_, const Spec & spec_, const char * val_);
+
+template <typename T>
+void appendArg(LogStream *, std::string & out_, const Spec & spec_, const T & val_, CStringKind) {
+	append(out_, spec_, (const char*)val_);
+}
+
+template <typename T>
+void appendArg(LogStream *, std::string & out_, const Spec & spec_, const T & val_, StringKind) {
+	append(out_, spec_, val_.data(), val_.size());
+}
+
+template <typename T>
+void appendArg(LogStream *, std::string & out_, const Spec & spec_, const T & val_, PointerKind) {
+	append(out_, spec_, (const void*)val_);
+}
+
+template <typename T>
+void appendArg(LogStream * stream_, std::string & out_, const Spec & spec_, const T & val_, OtherKind) {
+	// Slow path - format the value by operator<< (in the stream buffer, the message of the record holds the output).
+	stream_->buf.reset();
+	(*stream_) << val_;
+	append(out_, spec_, stream_->buf.data(), stream_->buf.size());
+}
+
+/*!
+ * Formats the rest of the format string (with no arguments left).
+ */
+inline void formatArgs(LogStream *, std::string & out_, const char * f_) {
+	Spec spec;
+	nextSpec(out_, f_, spec);
+}
+
+/*!
+ * Formats the text up to the next placeholder, the argument, and the rest of the format string with the remaining arguments.
+ */
+template <typename T, typename... Rest>
+void formatArgs(LogStream * stream_, std::string & out_, const char * f_, const T & val_, const Rest&... rest_) {
+	Spec spec;
+	if (!nextSpec(out_, f_, spec))
+		return;
+	appendArg(stream_, out_, spec, val_, typename ArgumentKind<T>::type());
+	formatArgs(stream_, out_, f_, rest_...);
+}
+
+} /* namespace format */
+
+
+/*!
+ * Formats the message and passes it to the logger - called by the LOGF macro.
+ * The message is formatted into the record of the thread-local LogStream, so in steady state no memory is allocated.
+ * @tparam Placeholders Number of placeholders in the format string (-1 - invalid format string).
+ * @tparam Arguments Number of arguments.
+ * @param parent_ Logger.
+ * @param site_ Call site.
+ * @param sev_ Severity.
+ * @param fmt_ Format string.
+ * @param args_ Arguments.
+ */
+template <int Placeholders, int Arguments, typename... Args>
+void logFormatted(Logger * parent_, const LogSite & site_, Severity_t sev_, const char * fmt_, const Args&... args_) {
+	static_assert(Placeholders >= 0, "LOGF: invalid format string (unmatched brace or invalid placeholder)");
+	static_assert(Placeholders == Arguments, "LOGF: number of arguments does not match the number of placeholders");
+	LogStream * stream = LogStream::acquire();
+	stream->record.message.clear();
+	format::formatArgs(stream, stream->record.message, fmt_, args_...);
+	stream->record.site = site_.id;
+	stream->record.severity = sev_;
+	stream->record.binary = false;
+	stream->record.timestamp = monotonicNs();
+	stream->record.thread = threadId();
+	parent_->log(stream->record);
+	LogStream::release(stream);
+}
+
+} /* namespace logger */
+} /* namespace mic */
+
+#endif /* SRC_LOGGER_LOGFORMAT_HPP_ */
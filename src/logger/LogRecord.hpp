@@ -0,0 +1,69 @@
+/*!
+ * Copyright (C) tkornuta, IBM Corporation 2015-2019
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+/*!
+ * \file LogRecord.hpp
+ * \brief Contains definition of a log record, i.e. a single message travelling from the logger to its outputs.
+ * \author tkornuta
+ * \date Oct 17, 2026
+ */
+
+#ifndef SRC_LOGGER_LOGRECORD_HPP_
+#define SRC_LOGGER_LOGRECORD_HPP_
+
+#include <logger/LoggerAux.hpp>
+#include <logger/LogSite.hpp>
+#include <logger/LogClock.hpp>
+
+#include <string>
+
+namespace mic {
+namespace logger {
+
+/*!
+ * \brief Single log record - stores everything that is passed to logger outputs.
+ * Records are kept in the asynchronous logger queue, so their strings are reused (assigned, not reallocated) between messages.
+ * The call site (file, line, function) is identified by id.
+ * \author tkornuta
+ */
+struct LogRecord {
+	/// Id of the call site (see LogSiteRegistry).
+	uint32_t site;
+
+	/// Log (message) severity.
+	Severity_t severity;
+
+	/// Message contents - text or binary arguments (see BinaryFormat.hpp).
+	std::string message;
+
+	/// Flag denoting whether the message contains binary arguments.
+	bool binary;
+
+	/// Monotonic time (in ns) at which the message was logged (see monotonicNs()).
+	int64_t timestamp;
+
+	/// Compact id of the thread that logged the message (see threadId()).
+	uint32_t thread;
+
+	/*!
+	 * Default constructor.
+	 */
+	LogRecord() : site(LogSiteRegistry::unknown_site), severity(Trace), binary(false), timestamp(0), thread(0) { }
+};
+
+} /* namespace logger */
+} /* namespace mic */
+
+#endif /* SRC_LOGGER_LOGRECORD_HPP_ */
@@ -0,0 +1,227 @@
+/*!
+ * Copyright (C) tkornuta, IBM Corporation 2015-2019
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+/*!
+ * \file LogRing.cpp
+ * \brief Contains definitions of methods of the LogRing class.
+ * \author tkornuta
+ * \date Oct 17, 2026
+ */
+
+#include <logger/LogRing.hpp>
+#include <logger/LogClock.hpp>
+#include <logger/BinaryFormat.hpp>
+
+#include <boost/atomic.hpp>
+
+#include <algorithm>
+#include <sstream>
+#include <cstring>
+
+namespace mic {
+namespace logger {
+
+namespace {
+
+/// Magic string at the beginning of the ring.
+const char ring_magic[] = "MICRING1";
+
+/*!
+ * \brief Header of the ring (all numbers in native byte order).
+ */
+struct RingHeader {
+	/// Magic string.
+	char magic[8];
+
+	/// Size of the slot.
+	uint32_t slot_size;
+
+	/// Number of slots.
+	uint32_t slots;
+
+	/// Difference between the wall-clock and the monotonic time of the writing process (ns).
+	int64_t wall_offset;
+
+	/// Number of records stored so far (sequence number of the next record).
+	boost::atomic<uint64_t> next;
+
+	/// Padding - slots start at the cache line.
+	char padding[32];
+};
+
+/*!
+ * \brief Header of the slot, followed by the message.
+ */
+struct SlotHeader {
+	/// Sequence number of the record + 1 (0 - empty slot or a record being written).
+	boost::atomic<uint64_t> seq;
+
+	/// Monotonic timestamp.
+	int64_t timestamp;
+
+	/// Thread id.
+	uint32_t thread;
+
+	/// Line.
+	int32_t line;
+
+	/// Length of the message.
+	uint16_t length;
+
+	/// Severity.
+	uint8_t severity;
+
+	/// Flags (SlotBinary, SlotTruncated).
+	uint8_t flags;
+
+	/// Name of the file (truncated, zero-terminated).
+	char file[28];
+};
+
+/// Flag denoting that the message contains binary arguments.
+const uint8_t SlotBinary = 1;
+
+/// Flag denoting that the message was truncated.
+const uint8_t SlotTruncated = 2;
+
+static_assert(sizeof(RingHeader) == 64, "Unexpected size of the ring header");
+static_assert(sizeof(SlotHeader) == 56, "Unexpected size of the slot header");
+
+} /* namespace */
+
+
+std::string RingEntry::text() const {
+	if (!binary)
+		return message;
+	std::ostringstream os;
+	if (!binary::formatArguments(message.data(), message.size(), os) && !truncated)
+		os << " <corrupted binary arguments>";
+	return os.str();
+}
+
+
+void RingEntry::print(std::ostream & os_) const {
+	char time[timestamp_length];
+	os_.write(time, formatWallClock(wall_time, time));
+	os_ << " #" << thread << " " << sev2str(severity) << " in " << file << " [" << line << "]: " << text();
+	if (truncated)
+		os_ << " [truncated]";
+	os_ << '\n';
+}
+
+
+size_t LogRing::mappingSize(size_t slots_, size_t slot_size_) {
+	return sizeof(RingHeader) + slots_ * slot_size_;
+}
+
+
+size_t LogRing::slotSize(size_t slot_size_) {
+	return std::min<size_t>(std::max<size_t>((slot_size_ + 7) & ~(size_t)7, sizeof(SlotHeader) + 8), sizeof(SlotHeader) + 0xfff8);
+}
+
+
+LogRing::LogRing(char * data_, size_t slots_, size_t slot_size_) :
+	data(data_), slots(slots_), slot_size(slot_size_)
+{
+	RingHeader * header = (RingHeader*)data;
+	header->slot_size = slot_size;
+	header->slots = slots;
+	header->wall_offset = wallClockOffset();
+	header->next.store(0, boost::memory_order_relaxed);
+	boost::atomic_thread_fence(boost::memory_order_release);
+	std::memcpy(header->magic, ring_magic, sizeof(header->magic));
+}
+
+
+LogRing::LogRing(const char * data_, size_t size_) :
+	data(NULL), slots(0), slot_size(0)
+{
+	const RingHeader * header = (const RingHeader*)data_;
+	if ((size_ < sizeof(RingHeader)) || (std::memcmp(header->magic, ring_magic, sizeof(header->magic)) != 0))
+		return;
+	if ((header->slots == 0) || (header->slot_size < sizeof(SlotHeader)) || (size_ < mappingSize(header->slots, header->slot_size)))
+		return;
+	// Readers never write into the mapping.
+	data = const_cast<char*>(data_);
+	slots = header->slots;
+	slot_size = header->slot_size;
+}
+
+
+void LogRing::store(const char * msg_, size_t size_, bool binary_, Severity_t sev_, const char * file_, int line_, int64_t timestamp_, uint32_t thread_) {
+	RingHeader * header = (RingHeader*)data;
+	uint64_t seq = header->next.fetch_add(1, boost::memory_order_relaxed);
+	SlotHeader * slot = (SlotHeader*)(data + sizeof(RingHeader) + (seq % slots) * slot_size);
+
+	// Mark the slot as being written.
+	slot->seq.store(0, boost::memory_order_relaxed);
+	boost::atomic_thread_fence(boost::memory_order_release);
+
+	size_t capacity = slot_size - sizeof(SlotHeader);
+	size_t len = std::min(size_, capacity);
+	slot->timestamp = timestamp_;
+	slot->thread = thread_;
+	slot->line = line_;
+	slot->length = (uint16_t)len;
+	slot->severity = (uint8_t)sev_;
+	slot->flags = (binary_ ? SlotBinary : 0) | ((len < size_) ? SlotTruncated : 0);
+	std::strncpy(slot->file, file_, sizeof(slot->file) - 1);
+	slot->file[sizeof(slot->file) - 1] = '\0';
+	std::memcpy((char*)slot + sizeof(SlotHeader), msg_, len);
+
+	slot->seq.store(seq + 1, boost::memory_order_release);
+}
+
+
+uint64_t LogRing::next() const {
+	return ((const RingHeader*)data)->next.load(boost::memory_order_acquire);
+}
+
+
+RingRead_t LogRing::read(uint64_t seq_, RingEntry & entry_) const {
+	const RingHeader * header = (const RingHeader*)data;
+	const SlotHeader * slot = (const SlotHeader*)(data + sizeof(RingHeader) + (seq_ % slots) * slot_size);
+	uint64_t seq = slot->seq.load(boost::memory_order_acquire);
+	if (seq != seq_ + 1)
+		return ((seq > seq_ + 1) || (next() >= seq_ + slots + 1)) ? RingOverwritten : RingNotYet;
+
+	// Copy the fields, then check that the slot was not overwritten meanwhile.
+	size_t len = std::min<size_t>(slot->length, slot_size - sizeof(SlotHeader));
+	entry_.seq = seq_;
+	entry_.wall_time = slot->timestamp + header->wall_offset;
+	entry_.thread = slot->thread;
+	entry_.severity = (Severity_t)std::min<int>(slot->severity, Fatal);
+	entry_.file.assign(slot->file, strnlen(slot->file, sizeof(slot->file)));
+	entry_.line = slot->line;
+	entry_.message.assign((const char*)slot + sizeof(SlotHeader), len);
+	entry_.binary = (slot->flags & SlotBinary) != 0;
+	entry_.truncated = (slot->flags & SlotTruncated) != 0;
+	boost::atomic_thread_fence(boost::memory_order_acquire);
+	if (slot->seq.load(boost::memory_order_relaxed) != seq)
+		return RingOverwritten;
+	return RingOk;
+}
+
+
+void LogRing::dump(std::ostream & os_) const {
+	uint64_t end = next();
+	RingEntry entry;
+	for (uint64_t seq = (end > slots) ? end - slots : 0; seq < end; seq++)
+		if (read(seq, entry) == RingOk)
+			entry.print(os_);
+}
+
+} /* namespace logger */
+} /* namespace mic */
@@ -0,0 +1,177 @@
+/*!
+ * Copyright (C) tkornuta, IBM Corporation 2015-2019
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+/*!
+ * \file LogRing.hpp
+ * \brief Contains declaration of the LogRing class - ring of log records in a shared memory mapping (file or shared memory object).
+ * \author tkornuta
+ * \date Oct 17, 2026
+ */
+
+#ifndef SRC_LOGGER_LOGRING_HPP_
+#define SRC_LOGGER_LOGRING_HPP_
+
+#include <logger/LoggerAux.hpp>
+
+#include <boost/cstdint.hpp>
+
+#include <ostream>
+#include <string>
+
+namespace mic {
+namespace logger {
+
+/*!
+ * \brief Status of reading the record from the ring.
+ * \author tkornuta
+ */
+enum RingRead_t
+{
+	RingOk = 0, ///< Record was read.
+	RingNotYet, ///< Record was not written yet (or is being written).
+	RingOverwritten ///< Record was already overwritten by a newer one.
+};
+
+/*!
+ * \brief Single record read from the ring.
+ * \author tkornuta
+ */
+struct RingEntry {
+	/// Sequence number of the record.
+	uint64_t seq;
+
+	/// Wall-clock time in nanoseconds since the epoch.
+	int64_t wall_time;
+
+	/// Thread id.
+	uint32_t thread;
+
+	/// Severity.
+	Severity_t severity;
+
+	/// Name of the file (possibly truncated).
+	std::string file;
+
+	/// Line.
+	int line;
+
+	/// Message - text or binary arguments.
+	std::string message;
+
+	/// Flag denoting that the message contains binary arguments.
+	bool binary;
+
+	/// Flag denoting that the message was truncated.
+	bool truncated;
+
+	/*!
+	 * Returns the message as text (formats the binary arguments).
+	 */
+	std::string text() const;
+
+	/*!
+	 * Prints the record as a single line "YYYY-MM-DD HH:MM:SS.mmm #thread SEVERITY in file [line]: message".
+	 */
+	void print(std::ostream & os_) const;
+};
+
+/*!
+ * \class LogRing
+ * \brief Ring of fixed-size slots holding log records, placed in a memory mapping shared with other processes (or with the disk).
+ * Writers claim slots with a single atomic increment and copy the record into the slot - there are no locks and no system calls,
+ * and they never wait for readers. Every slot is guarded by its sequence number (seqlock), so readers (in this or other process)
+ * detect records being written or overwritten. The ring starts with a header describing its geometry, so readers need no configuration.
+ * \author tkornuta
+ */
+class LogRing {
+public:
+	/*!
+	 * Returns the size of the mapping needed for the ring.
+	 * @param slots_ Number of slots.
+	 * @param slot_size_ Size of the slot (see slotSize()).
+	 */
+	static size_t mappingSize(size_t slots_, size_t slot_size_);
+
+	/*!
+	 * Returns the supported size of the slot closest to the requested one (aligned, large enough for the slot header).
+	 */
+	static size_t slotSize(size_t slot_size_);
+
+	/*!
+	 * Initializes an empty ring in the (zeroed) mapping and attaches to it.
+	 * @param data_ Mapping of (at least) mappingSize() bytes.
+	 * @param slots_ Number of slots.
+	 * @param slot_size_ Size of the slot (see slotSize()).
+	 */
+	LogRing(char * data_, size_t slots_, size_t slot_size_);
+
+	/*!
+	 * Attaches to the ring existing in the mapping. Check valid() before using it.
+	 * @param data_ Mapping.
+	 * @param size_ Size of the mapping.
+	 */
+	LogRing(const char * data_, size_t size_);
+
+	/*!
+	 * Returns true if the ring is valid (has correct magic and fits in the mapping).
+	 */
+	bool valid() const {
+		return data != NULL;
+	}
+
+	/*!
+	 * Returns the number of slots.
+	 */
+	size_t getSlots() const {
+		return slots;
+	}
+
+	/*!
+	 * Stores the record in the next slot.
+	 */
+	void store(const char * msg_, size_t size_, bool binary_, Severity_t sev_, const char * file_, int line_, int64_t timestamp_, uint32_t thread_);
+
+	/*!
+	 * Returns the number of records stored so far (i.e. the sequence number of the next record).
+	 */
+	uint64_t next() const;
+
+	/*!
+	 * Reads the record with given sequence number.
+	 * @param seq_ Sequence number.
+	 * @param entry_ Read record.
+	 */
+	RingRead_t read(uint64_t seq_, RingEntry & entry_) const;
+
+	/*!
+	 * Prints all records kept in the ring, from the oldest one.
+	 */
+	void dump(std::ostream & os_) const;
+
+private:
+	/// Beginning of the mapping (NULL if the ring is not valid).
+	char * data;
+
+	/// Number of slots.
+	size_t slots;
+
+	/// Size of the slot.
+	size_t slot_size;
+};
+
+} /* namespace logger */
+} /* namespace mic */
+
+#endif /* SRC_LOGGER_LOGRING_HPP_ */
@@ -0,0 +1,147 @@
+/*!
+ * Copyright (C) tkornuta, IBM Corporation 2015-2019
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+/*!
+ * \file LogSampler.hpp
+ * \brief Contains definition of the LogSampler class, used by the sampling (rate limiting) LOG macros.
+ * \author tkornuta
+ * \date Oct 17, 2026
+ */
+
+#ifndef SRC_LOGGER_LOGSAMPLER_HPP_
+#define SRC_LOGGER_LOGSAMPLER_HPP_
+
+#include <boost/atomic.hpp>
+#include <boost/cstdint.hpp>
+
+#include <chrono>
+#include <limits>
+
+namespace mic {
+namespace logger {
+
+/*!
+ * \class LogSampler
+ * \brief State of a single sampled (rate limited) call site - every site has its own static instance.
+ * Every method decides whether the current occurrence should be logged and returns the number of occurrences suppressed since the last logged one,
+ * or Suppressed when the current one should be skipped.
+ * \author tkornuta
+ */
+class LogSampler {
+public:
+	/// Value returned when the occurrence should not be logged.
+	static const uint64_t Suppressed = ~(uint64_t)0;
+
+	/*!
+	 * Constructor.
+	 */
+	LogSampler() : occurrences(0), suppressed(0), next_time(0) { }
+
+	/*!
+	 * Passes every n-th occurrence (starting with the first one).
+	 * @param n_ Period.
+	 */
+	uint64_t everyN(uint64_t n_) {
+		uint64_t c = occurrences.fetch_add(1, boost::memory_order_relaxed);
+		if ((n_ > 1) && (c % n_ != 0))
+			return suppress();
+		return collect();
+	}
+
+	/*!
+	 * Passes the first n occurrences.
+	 * @param n_ Number of passed occurrences.
+	 */
+	uint64_t firstN(uint64_t n_) {
+		// Stop counting after reaching the limit, so the counter never wraps.
+		if (occurrences.load(boost::memory_order_relaxed) >= n_)
+			return Suppressed;
+		if (occurrences.fetch_add(1, boost::memory_order_relaxed) >= n_)
+			return Suppressed;
+		return 0;
+	}
+
+	/*!
+	 * Passes at most one occurrence per given time period.
+	 * @param period_ms_ Period in milliseconds.
+	 */
+	uint64_t everyT(uint64_t period_ms_) {
+		int64_t now = nowNs();
+		int64_t next = next_time.load(boost::memory_order_relaxed);
+		if ((now < next) || !next_time.compare_exchange_strong(next, now + (int64_t)period_ms_ * 1000000, boost::memory_order_relaxed))
+			return suppress();
+		return collect();
+	}
+
+	/*!
+	 * Token bucket - passes at most rate occurrences per second on average, with bursts of up to burst occurrences.
+	 * Implemented as GCRA (virtual scheduling), so the whole bucket state is a single atomic.
+	 * @param rate_ Number of occurrences per second.
+	 * @param burst_ Size of the bucket.
+	 */
+	uint64_t rateLimited(double rate_, uint64_t burst_) {
+		int64_t interval = (rate_ > 0) ? (int64_t)(1e9 / rate_) : std::numeric_limits<int64_t>::max() / 4;
+		int64_t tolerance = interval * (int64_t)(burst_ > 0 ? burst_ - 1 : 0);
+		int64_t now = nowNs();
+		int64_t tat = next_time.load(boost::memory_order_relaxed);
+		for (;;) {
+			if (tat - tolerance > now)
+				return suppress();
+			int64_t new_tat = ((tat > now) ? tat : now) + interval;
+			if (next_time.compare_exchange_weak(tat, new_tat, boost::memory_order_relaxed))
+				break;
+		}//: for
+		return collect();
+	}
+
+private:
+	/*!
+	 * Counts the suppressed occurrence.
+	 */
+	uint64_t suppress() {
+		suppressed.fetch_add(1, boost::memory_order_relaxed);
+		return Suppressed;
+	}
+
+	/*!
+	 * Returns (and resets) the number of suppressed occurrences.
+	 */
+	uint64_t collect() {
+		if (suppressed.load(boost::memory_order_relaxed) == 0)
+			return 0;
+		return suppressed.exchange(0, boost::memory_order_relaxed);
+	}
+
+	/*!
+	 * Returns the current (steady) time in nanoseconds.
+	 */
+	static int64_t nowNs() {
+		return std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now().time_since_epoch()).count();
+	}
+
+	/// Number of occurrences.
+	boost::atomic<uint64_t> occurrences;
+
+	/// Number of occurrences suppressed since the last logged one.
+	boost::atomic<uint64_t> suppressed;
+
+	/// Time (in ns) from which the next occurrence can be logged - or theoretical arrival time of the token bucket.
+	boost::atomic<int64_t> next_time;
+};
+
+} /* namespace logger */
+} /* namespace mic */
+
+#endif /* SRC_LOGGER_LOGSAMPLER_HPP_ */
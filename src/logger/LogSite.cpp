@@ -0,0 +1,296 @@
+/*!
+ * Copyright (C) tkornuta, IBM Corporation 2015-2019
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+/*!
+ * \file LogSite.cpp
+ * \brief Contains definitions of methods of the log site registry.
+ * \author tkornuta
+ * \date Oct 17, 2026
+ */
+
+#include <logger/LogSite.hpp>
+
+#include <boost/thread/mutex.hpp>
+#include <boost/unordered_map.hpp>
+#include <boost/ptr_container/ptr_vector.hpp>
+
+#include <stdexcept>
+#include <cstdio>
+
+namespace mic {
+namespace logger {
+
+/*!
+ * \brief State of the registry.
+ */
+struct LogSiteRegistry::State {
+	/// Mutex protecting registration of sites.
+	boost::mutex mutex;
+
+	/// Number of registered sites.
+	boost::atomic<uint32_t> count;
+
+	/// Table of chunks.
+	boost::atomic<const LogSite * const *> chunks[max_chunks];
+
+	/// Chunks (written under mutex).
+	std::vector<const LogSite **> owned_chunks;
+
+	/// Site used for messages with no known site.
+	LogSite unknown;
+
+	/// Type of the map of interned sites.
+	typedef boost::unordered_map<std::pair<std::string, int>, const LogSite*> InternMap;
+
+	/// Sites created for messages logged with the (file, line) interface.
+	InternMap interned;
+
+	/// Interned sites (owned).
+	boost::ptr_vector<LogSite> interned_sites;
+
+	/*!
+	 * \brief Dynamic debug rule.
+	 */
+	struct Rule {
+		/// Mode set by the rule.
+		SiteMode_t mode;
+
+		/// Pattern matched against the file name (or the function name, if there is no colon in the rule).
+		std::string file_pattern;
+
+		/// Pattern matched against the line or the function name (empty if there is no colon in the rule).
+		std::string site_pattern;
+	};
+
+	/// Dynamic debug rules.
+	std::vector<Rule> rules;
+
+	/// Dynamic debug rules (as set).
+	std::string rules_string;
+
+	/// Threshold of sites in default mode.
+	int default_threshold;
+
+	State() : count(0), unknown("unknown", 0, Trace, "", unknown_site), default_threshold(Fatal + 1) {
+		for (uint32_t i = 0; i < max_chunks; i++)
+			chunks[i].store(NULL, boost::memory_order_relaxed);
+		store(&unknown);
+	}
+
+	/*!
+	 * Stores the site in the next free slot - called under mutex.
+	 */
+	uint32_t store(const LogSite * site_) {
+		uint32_t id = count.load(boost::memory_order_relaxed);
+		if ((id >> chunk_bits) >= max_chunks)
+			throw std::runtime_error("LogSiteRegistry: too many log sites");
+		if ((id & (chunk_size - 1)) == 0) {
+			// Allocate new chunk.
+			owned_chunks.push_back(new const LogSite*[chunk_size]);
+			chunks[id >> chunk_bits].store(owned_chunks.back(), boost::memory_order_release);
+		}//: if
+		owned_chunks[id >> chunk_bits][id & (chunk_size - 1)] = site_;
+		count.store(id + 1, boost::memory_order_release);
+		return id;
+	}
+};
+
+
+LogSite::LogSite(const char * file_, int line_, Severity_t severity_, const char * function_, const LogCategory & category_) :
+	file(file_), file_name(file_), line(line_), severity(severity_), function(function_), category(&category_),
+	threshold(Fatal + 1), mode(SiteDefault), forced(false), id(LogSiteRegistry::add(this))
+{
+
+}
+
+
+LogSite::LogSite(const char * file_, int line_, Severity_t severity_, const char * function_, uint32_t id_) :
+	file(file_), file_name(file_), line(line_), severity(severity_), function(function_), category(&LogCategory::root()),
+	threshold(Fatal + 1), mode(SiteDefault), forced(false), id(id_)
+{
+
+}
+
+
+LogSiteRegistry::State & LogSiteRegistry::state() {
+	// Never destroyed - messages can be logged until the very end of the program (e.g. at exit).
+	static State * s = new State();
+	return *s;
+}
+
+
+boost::atomic<const LogSite * const *> * LogSiteRegistry::chunks() {
+	return state().chunks;
+}
+
+
+uint32_t LogSiteRegistry::size() {
+	return state().count.load(boost::memory_order_acquire);
+}
+
+
+uint32_t LogSiteRegistry::add(const LogSite * site_) {
+	State & s = state();
+	boost::mutex::scoped_lock lock(s.mutex);
+	uint32_t id = s.store(site_);
+	updateSite(s, *site_);
+	return id;
+}
+
+
+const LogSite & LogSiteRegistry::intern(const std::string & file_, int line_, Severity_t severity_) {
+	State & s = state();
+	boost::mutex::scoped_lock lock(s.mutex);
+	State::InternMap::iterator it = s.interned.find(std::make_pair(file_, line_));
+	if (it == s.interned.end()) {
+		// Create the site - the file name is kept by the key of the map.
+		it = s.interned.insert(std::make_pair(std::make_pair(file_, line_), (const LogSite*)NULL)).first;
+		s.interned_sites.push_back(new LogSite(it->first.first.c_str(), line_, severity_, "", s.count.load(boost::memory_order_relaxed)));
+		s.store(&s.interned_sites.back());
+		updateSite(s, s.interned_sites.back());
+		it->second = &s.interned_sites.back();
+	}//: if
+	return *it->second;
+}
+
+void LogSiteRegistry::setDynamicDebug(const std::string & rules_) {
+	State & s = state();
+	boost::mutex::scoped_lock lock(s.mutex);
+
+	// Parse the rules.
+	s.rules.clear();
+	s.rules_string = rules_;
+	size_t pos = 0;
+	while (pos < rules_.size()) {
+		size_t end = rules_.find_first_of(" \t,;", pos);
+		if (end == std::string::npos)
+			end = rules_.size();
+		std::string token = rules_.substr(pos, end - pos);
+		pos = end + 1;
+		if (token.empty())
+			continue;
+
+		State::Rule rule;
+		rule.mode = SiteEnabled;
+		if ((token[0] == '+') || (token[0] == '-')) {
+			rule.mode = (token[0] == '+') ? SiteEnabled : SiteDisabled;
+			token.erase(0, 1);
+		}//: if
+		size_t colon = token.find(':');
+		if (colon != std::string::npos) {
+			rule.file_pattern = token.substr(0, colon);
+			rule.site_pattern = token.substr(colon + 1);
+		} else
+			rule.file_pattern = token;
+		s.rules.push_back(rule);
+	}//: while
+
+	// Apply them to all sites.
+	uint32_t count = s.count.load(boost::memory_order_relaxed);
+	for (uint32_t i = 1; i < count; i++)
+		updateSite(s, get(i));
+}
+
+
+std::string LogSiteRegistry::getDynamicDebug() {
+	State & s = state();
+	boost::mutex::scoped_lock lock(s.mutex);
+	return s.rules_string;
+}
+
+
+void LogSiteRegistry::setDefaultThreshold(int threshold_) {
+	State & s = state();
+	boost::mutex::scoped_lock lock(s.mutex);
+	if (s.default_threshold == threshold_)
+		return;
+	s.default_threshold = threshold_;
+	uint32_t count = s.count.load(boost::memory_order_relaxed);
+	for (uint32_t i = 1; i < count; i++)
+		updateSite(s, get(i));
+}
+
+
+void LogSiteRegistry::updateSites() {
+	State & s = state();
+	boost::mutex::scoped_lock lock(s.mutex);
+	uint32_t count = s.count.load(boost::memory_order_relaxed);
+	for (uint32_t i = 1; i < count; i++)
+		updateSite(s, get(i));
+}
+
+
+void LogSiteRegistry::updateSite(State & state_, const LogSite & site_) {
+	// The last matching rule wins.
+	SiteMode_t mode = SiteDefault;
+	for (std::vector<State::Rule>::const_reverse_iterator it = state_.rules.rbegin(); it != state_.rules.rend(); ++it) {
+		bool match;
+		if (it->site_pattern.empty())
+			match = globMatch(it->file_pattern.c_str(), site_.file) || globMatch(it->file_pattern.c_str(), site_.function);
+		else {
+			char line[16];
+			std::snprintf(line, sizeof(line), "%d", site_.line);
+			match = globMatch(it->file_pattern.c_str(), site_.file) &&
+					(globMatch(it->site_pattern.c_str(), line) || globMatch(it->site_pattern.c_str(), site_.function));
+		}//: else
+		if (match) {
+			mode = it->mode;
+			break;
+		}//: if
+	}//: for
+
+	site_.mode.store(mode, boost::memory_order_relaxed);
+	int category_threshold = site_.category->getThreshold();
+	if (mode == SiteEnabled) {
+		site_.threshold.store(Trace, boost::memory_order_relaxed);
+		site_.forced.store(true, boost::memory_order_relaxed);
+	} else if (mode == SiteDisabled) {
+		site_.threshold.store(Fatal + 1, boost::memory_order_relaxed);
+		site_.forced.store(false, boost::memory_order_relaxed);
+	} else if (category_threshold != LogCategory::no_level) {
+		// The level of the category replaces the levels of outputs.
+		site_.threshold.store(category_threshold, boost::memory_order_relaxed);
+		site_.forced.store(true, boost::memory_order_relaxed);
+	} else {
+		site_.threshold.store(state_.default_threshold, boost::memory_order_relaxed);
+		site_.forced.store(false, boost::memory_order_relaxed);
+	}//: else
+}
+
+
+bool LogSiteRegistry::globMatch(const char * pattern_, const char * text_) {
+	// Iterative matching with backtracking to the last star.
+	const char * star = NULL;
+	const char * resume = NULL;
+	while (*text_) {
+		if ((*pattern_ == '?') || (*pattern_ == *text_)) {
+			pattern_++;
+			text_++;
+		} else if (*pattern_ == '*') {
+			star = pattern_++;
+			resume = text_;
+		} else if (star) {
+			pattern_ = star + 1;
+			text_ = ++resume;
+		} else
+			return false;
+	}//: while
+	while (*pattern_ == '*')
+		pattern_++;
+	return *pattern_ == '\0';
+}
+
+} /* namespace logger */
+} /* namespace mic */
@@ -0,0 +1,259 @@
+/*!
+ * Copyright (C) tkornuta, IBM Corporation 2015-2019
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+/*!
+ * \file LogSite.hpp
+ * \brief Contains definitions of the log call site descriptor and of the registry of all call sites.
+ * \author tkornuta
+ * \date Oct 17, 2026
+ */
+
+#ifndef SRC_LOGGER_LOGSITE_HPP_
+#define SRC_LOGGER_LOGSITE_HPP_
+
+#include <logger/LoggerAux.hpp>
+#include <logger/LogCategory.hpp>
+
+#include <boost/atomic.hpp>
+#include <boost/cstdint.hpp>
+
+#include <string>
+#include <vector>
+
+namespace mic {
+namespace logger {
+
+/*!
+ * \brief Mode of the log site set by the dynamic debug rules.
+ * \author tkornuta
+ */
+enum SiteMode_t
+{
+	SiteDefault = 0, ///< Messages are filtered by the severity levels of outputs.
+	SiteEnabled, ///< Messages of all severities are logged, bypassing the levels of outputs.
+	SiteDisabled ///< No messages are logged.
+};
+
+/*!
+ * Auxiliary function returning the part of the path after the last slash - evaluated at compile time for string literals.
+ * @param path_ Remaining part of the path.
+ * @param last_ Beginning of the last path component found so far.
+ */
+constexpr const char * baseNameImpl(const char * path_, const char * last_) {
+	return (*path_ == '\0') ? last_ : baseNameImpl(path_ + 1, (*path_ == '/') ? (path_ + 1) : last_);
+}
+
+/*!
+ * Returns the name of the file (the part of the path after the last slash).
+ * @param path_ Path.
+ */
+constexpr const char * baseName(const char * path_) {
+	return baseNameImpl(path_, path_);
+}
+
+
+/*!
+ * \struct LogSite
+ * \brief Descriptor of a single log call site (LOG statement) - created once, when the statement is executed for the first time.
+ * Every site is assigned a small integer id, records carry this id instead of the file name and line.
+ * \author tkornuta
+ */
+struct LogSite {
+	/*!
+	 * Constructor. Registers the site in the LogSiteRegistry.
+	 * @param file_ Name of the file (must outlive the site, e.g. a string literal).
+	 * @param line_ Line.
+	 * @param severity_ Severity of the statement.
+	 * @param function_ Name of the function (must outlive the site).
+	 * @param category_ Category of the site.
+	 */
+	LogSite(const char * file_, int line_, Severity_t severity_, const char * function_, const LogCategory & category_ = LogCategory::root());
+
+	/// Name of the file.
+	const char * file;
+
+	/// Name of the file - as string, passed to the outputs using the (file, line) interface.
+	const std::string file_name;
+
+	/// Line in the file.
+	const int line;
+
+	/// Severity of the statement (when the statement logs with different severities - the one it was first executed with).
+	const Severity_t severity;
+
+	/// Name of the function.
+	const char * function;
+
+	/// Category of the site.
+	const LogCategory * category;
+
+	/*!
+	 * Checks whether a message of given severity is logged by the site - costs a single relaxed atomic load.
+	 * @param sev_ Message severity.
+	 */
+	bool isEnabled(Severity_t sev_) const {
+		return (int)sev_ >= threshold.load(boost::memory_order_relaxed);
+	}
+
+	/*!
+	 * Returns true if the messages of the site bypass the levels of outputs accepting forced records (see LoggerOutput::setForcedRecords()) -
+	 * when the site was enabled by the dynamic debug rules or when its category has a level.
+	 */
+	bool isForced() const {
+		return forced.load(boost::memory_order_relaxed);
+	}
+
+	/*!
+	 * Returns the mode of the site.
+	 */
+	SiteMode_t getMode() const {
+		return (SiteMode_t)mode.load(boost::memory_order_relaxed);
+	}
+
+private:
+	/// Minimal severity of messages logged by the site - cached from the levels of outputs and the mode (updated by the registry).
+	mutable boost::atomic<int> threshold;
+
+	/// Mode of the site.
+	mutable boost::atomic<int> mode;
+
+	/// Flag denoting that the messages of the site bypass the levels of outputs accepting forced records.
+	mutable boost::atomic<bool> forced;
+
+public:
+	/// Id of the site.
+	const uint32_t id;
+
+private:
+	friend class LogSiteRegistry;
+
+	/*!
+	 * Constructor used by the registry - creates the site with given id, without registering it.
+	 */
+	LogSite(const char * file_, int line_, Severity_t severity_, const char * function_, uint32_t id_);
+
+	LogSite(const LogSite &);
+	LogSite& operator =(const LogSite&);
+};
+
+
+/*!
+ * \class LogSiteRegistry
+ * \brief Registry of all log sites, enabling lookup of the site by id (without locking) and enumeration of the sites.
+ * Sites are stored in chunks that are allocated on demand and never moved or freed.
+ * \author tkornuta
+ */
+class LogSiteRegistry {
+public:
+	/// Id of the site used for messages with no known site.
+	static const uint32_t unknown_site = 0;
+
+	/*!
+	 * Returns the site with given id.
+	 * @param id_ Id of the site (smaller than size()).
+	 */
+	static const LogSite & get(uint32_t id_) {
+		const LogSite * const * chunk = chunks()[id_ >> chunk_bits].load(boost::memory_order_acquire);
+		return *chunk[id_ & (chunk_size - 1)];
+	}
+
+	/*!
+	 * Returns the number of registered sites (ids are 0 ... size()-1).
+	 */
+	static uint32_t size();
+
+	/*!
+	 * Sets the dynamic debug rules, applied to all existing and future sites (later rules override the earlier ones).
+	 * Rules are separated by spaces, commas or semicolons. Every rule is a glob pattern (with * and ?), optionally preceded by
+	 * + (enable the matching sites - default) or - (disable them). The pattern is matched against the file name or the function name,
+	 * a pattern with colon against the file name and the line or the function, e.g. "KeyHandlerRegistry.cpp:*", "-*.cpp:120", "*Episode*".
+	 * Empty string removes all rules.
+	 * Messages of the enabled sites are passed to outputs accepting forced records (see LoggerOutput::setForcedRecords(), e.g. ConsoleOutput)
+	 * regardless of their levels, other outputs still apply their own levels.
+	 * @param rules_ Rules.
+	 */
+	static void setDynamicDebug(const std::string & rules_);
+
+	/*!
+	 * Returns the current dynamic debug rules.
+	 */
+	static std::string getDynamicDebug();
+
+	/*!
+	 * Sets the threshold of sites in the default mode - called by the logger when the levels of outputs change.
+	 * @param threshold_ Minimal severity accepted by any output.
+	 */
+	static void setDefaultThreshold(int threshold_);
+
+	/*!
+	 * Recomputes the thresholds of all sites - called when the levels of categories change.
+	 */
+	static void updateSites();
+
+	/*!
+	 * Matches the text against the glob pattern (* - any sequence, ? - any character).
+	 */
+	static bool globMatch(const char * pattern_, const char * text_);
+
+	/*!
+	 * Returns the site for given file and line - registers the site if it does not exist.
+	 * Used by messages logged with the (file, line) interface, as a slow path.
+	 * @param file_ Name of the file.
+	 * @param line_ Line.
+	 * @param severity_ Severity.
+	 */
+	static const LogSite & intern(const std::string & file_, int line_, Severity_t severity_);
+
+private:
+	friend struct LogSite;
+
+	/// State of the registry.
+	struct State;
+
+	/*!
+	 * Returns the state of the registry (created on first use, so sites can be registered during static initialization).
+	 */
+	static State & state();
+
+	/// Number of bits of the site index within the chunk.
+	static const uint32_t chunk_bits = 8;
+
+	/// Size of the chunk.
+	static const uint32_t chunk_size = 1 << chunk_bits;
+
+	/// Maximal number of chunks.
+	static const uint32_t max_chunks = 4096;
+
+	/*!
+	 * Adds the site to the registry.
+	 * @return Id of the site.
+	 */
+	static uint32_t add(const LogSite * site_);
+
+	/*!
+	 * Returns the table of chunks.
+	 */
+	static boost::atomic<const LogSite * const *> * chunks();
+
+	/*!
+	 * Computes the mode and threshold of the site - called under mutex.
+	 */
+	static void updateSite(State & state_, const LogSite & site_);
+};
+
+} /* namespace logger */
+} /* namespace mic */
+
+#endif /* SRC_LOGGER_LOGSITE_HPP_ */
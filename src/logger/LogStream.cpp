@@ -0,0 +1,54 @@
+/*!
+ * Copyright (C) tkornuta, IBM Corporation 2015-2019
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+/*!
+ * \file LogStream.cpp
+ * \brief Contains definitions of methods managing the thread-local log streams.
+ * \author tkornuta
+ * \date Oct 17, 2026
+ */
+
+#include <logger/LogStream.hpp>
+
+namespace mic {
+namespace logger {
+
+namespace {
+
+/// Stream of the thread.
+thread_local LogStream thread_stream;
+
+} /* namespace */
+
+
+LogStream * LogStream::acquire() {
+	LogStream * stream = &thread_stream;
+	// Nested LOG statement (e.g. in operator<< of a logged object) - use a new stream.
+	if (stream->in_use)
+		stream = new LogStream();
+	stream->in_use = true;
+	stream->reset();
+	return stream;
+}
+
+
+void LogStream::release(LogStream * stream_) {
+	stream_->in_use = false;
+	if (stream_ != &thread_stream)
+		delete stream_;
+}
+
+} /* namespace logger */
+} /* namespace mic */
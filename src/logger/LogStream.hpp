@@ -0,0 +1,172 @@
+/*!
+ * Copyright (C) tkornuta, IBM Corporation 2015-2019
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+/*!
+ * \file LogStream.hpp
+ * \brief Contains definitions of the reusable (thread-local) stream used for formatting of log messages.
+ * \author tkornuta
+ * \date Oct 17, 2026
+ */
+
+#ifndef SRC_LOGGER_LOGSTREAM_HPP_
+#define SRC_LOGGER_LOGSTREAM_HPP_
+
+#include <ostream>
+#include <streambuf>
+#include <string>
+#include <vector>
+#include <cstring>
+
+#include <logger/LogRecord.hpp>
+
+namespace mic {
+namespace logger {
+
+/*!
+ * \class LogStreamBuf
+ * \brief Stream buffer writing into a growing memory block, which is kept (not freed) between messages.
+ */
+class LogStreamBuf : public std::streambuf {
+public:
+	/*!
+	 * Constructor. Allocates the initial memory block.
+	 * @param capacity_ Initial capacity.
+	 */
+	LogStreamBuf(size_t capacity_ = 512) : storage(capacity_) {
+		reset();
+	}
+
+	/*!
+	 * Clears the buffer (keeping its memory).
+	 */
+	void reset() {
+		setp(&storage[0], &storage[0] + storage.size());
+	}
+
+	/*!
+	 * Returns pointer to the formatted characters.
+	 */
+	const char * data() const {
+		return pbase();
+	}
+
+	/*!
+	 * Returns number of the formatted characters.
+	 */
+	size_t size() const {
+		return pptr() - pbase();
+	}
+
+protected:
+	/*!
+	 * Called when the buffer is full - grows it and stores the character.
+	 */
+	int_type overflow(int_type ch_) {
+		if (traits_type::eq_int_type(ch_, traits_type::eof()))
+			return traits_type::not_eof(ch_);
+		grow(1);
+		*pptr() = traits_type::to_char_type(ch_);
+		pbump(1);
+		return ch_;
+	}
+
+	/*!
+	 * Writes a block of characters at once.
+	 */
+	std::streamsize xsputn(const char * s_, std::streamsize n_) {
+		if (epptr() - pptr() < n_)
+			grow(n_);
+		std::memcpy(pptr(), s_, n_);
+		pbump((int)n_);
+		return n_;
+	}
+
+private:
+	/*!
+	 * Grows the memory block, so it can store at least given number of additional characters.
+	 */
+	void grow(size_t extra_) {
+		size_t used = size();
+		size_t new_size = storage.size() * 2;
+		if (new_size < used + extra_)
+			new_size = used + extra_;
+		storage.resize(new_size);
+		setp(&storage[0], &storage[0] + storage.size());
+		pbump((int)used);
+	}
+
+	/// Memory block.
+	std::vector<char> storage;
+};
+
+
+/*!
+ * \class LogStream
+ * \brief Output stream (with its buffers) used for formatting of log messages.
+ * Every thread has its own instance, reused by all LOG statements, so formatting of a message does not allocate memory in steady state.
+ */
+class LogStream : public std::ostream {
+public:
+	/*!
+	 * Constructor.
+	 */
+	LogStream() : std::ostream(&buf), in_use(false) { }
+
+	/*!
+	 * Returns the stream of the calling thread - or a new one, when the thread's stream is in use (nested LOG statements).
+	 * Must be released with release().
+	 */
+	static LogStream * acquire();
+
+	/*!
+	 * Releases the stream acquired by acquire().
+	 * @param stream_ Released stream.
+	 */
+	static void release(LogStream * stream_);
+
+	/*!
+	 * Clears the buffer and restores the default formatting flags.
+	 */
+	void reset() {
+		buf.reset();
+		clear();
+		flags(std::ios_base::dec | std::ios_base::skipws);
+		precision(6);
+		width(0);
+		fill(' ');
+	}
+
+	/*!
+	 * Copies the formatted characters into the message of the record (reusing its memory).
+	 */
+	const std::string & str() {
+		record.message.assign(buf.data(), buf.size());
+		return record.message;
+	}
+
+	/// Buffer storing formatted characters.
+	LogStreamBuf buf;
+
+	/// Record passed to the logger - its message is built from the formatted characters.
+	LogRecord record;
+
+	/// Flag denoting whether the stream is used.
+	bool in_use;
+};
+
+} /* namespace logger */
+} /* namespace mic */
+
+#endif /* SRC_LOGGER_LOGSTREAM_HPP_ */
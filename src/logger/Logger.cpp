@@ -23,16 +23,76 @@
 #include <logger/Logger.hpp>
 
 #include <boost/foreach.hpp>
+#include <boost/thread/lock_guard.hpp>
+
+#include <cstdlib>
+#include <cstdio>
 
 namespace mic {
 namespace logger {
 
+namespace {
+
+/// Flag set in the flush thread - records logged from it (e.g. by outputs) are printed synchronously.
+thread_local bool in_flush_thread = false;
+
+/// Maximal number of records printed by the flush thread before the outputs are flushed.
+const size_t flush_batch_size = 1024;
+
+/// Period in which the flush thread checks for expired windows of suppression of duplicates (in ns).
+const int64_t duplicates_check_period = 10000000;
+
+/*!
+ * Functor copying the record into a queue cell (reusing the capacity of its strings).
+ */
+struct RecordFiller {
+	const LogRecord & rec;
+
+	RecordFiller(const LogRecord & rec_) : rec(rec_) { }
+
+	void operator()(LogRecord & cell_) {
+		cell_.site = rec.site;
+		cell_.severity = rec.severity;
+		cell_.message = rec.message;
+		cell_.binary = rec.binary;
+		cell_.timestamp = rec.timestamp;
+		cell_.thread = rec.thread;
+	}
+};
+
+/*!
+ * Fills the record summarizing the suppressed repetitions of the last record of the site.
+ */
+void fillRepeatSummary(LogRecord & summary_, uint32_t site_, Severity_t severity_, size_t repeated_) {
+	char buf[64];
+	int len = std::snprintf(buf, sizeof(buf), "last message repeated %zu time%s", repeated_, (repeated_ == 1) ? "" : "s");
+	summary_.site = site_;
+	summary_.severity = severity_;
+	summary_.message.assign(buf, len);
+	summary_.binary = false;
+	summary_.timestamp = monotonicNs();
+	summary_.thread = threadId();
+}
+
+/*!
+ * Stops the asynchronous mode and flushes the outputs at exit - so no record is lost.
+ */
+void flushAtExit() {
+	Logger::getInstance()->stopAsync();
+	Logger::getInstance()->flush();
+}
+
+} /* namespace */
+
 // Init application instance - as NULL.
 boost::atomic<Logger*> Logger::instance_(NULL);
 
 // Initilize mutex.
 boost::mutex Logger::instantiation_mutex;
 
+// No outputs - nothing will be printed.
+boost::atomic<int> Logger::minimal_severity_level(Fatal + 1);
+
 
 Logger* Logger::getInstance() {
 	// Try to load the instance - first check.
@@ -55,40 +115,355 @@ Logger* Logger::getInstance() {
 }
 
 
-Logger::Logger() {
+Logger::Logger() : async(false), flush_thread_running(false), overflow_policy(BlockOnOverflow),
+	active_producers(0), pushed_records(0), popped_records(0), dropped_records(0), duplicate_window(0),
+	last_records(new boost::atomic<LastRecord*>[last_records_max_chunks]), pending_duplicates(0), suppressed_records(0)
+{
+	for (uint32_t i = 0; i < last_records_max_chunks; i++)
+		last_records[i].store(NULL, boost::memory_order_relaxed);
+
+	// Publish an empty list of outputs.
+	snapshots.push_back(new OutputList());
+	output_snapshot.store(&snapshots.back(), boost::memory_order_release);
+
+	// Make sure that the buffered/queued records will be written at exit.
+	std::atexit(&flushAtExit);
 }
 
 
 void Logger::addOutput(LoggerOutput * out) {
-	outputs.push_back(out);
+	{
+		boost::mutex::scoped_lock lock(outputs_mutex);
+		outputs.push_back(out);
+		// Copy-on-write: publish a new snapshot containing the added output.
+		OutputList * next = new OutputList(currentOutputs());
+		next->push_back(out);
+		snapshots.push_back(next);
+		output_snapshot.store(next, boost::memory_order_release);
+	}
+	updateMinimalSeverityLevel();
+}
+
+
+void Logger::updateMinimalSeverityLevel() {
+	boost::mutex::scoped_lock lock(outputs_mutex);
+	int min_lvl = Fatal + 1;
+	BOOST_FOREACH(LoggerOutput * output, currentOutputs()) {
+		if ((int)output->getLvl() < min_lvl)
+			min_lvl = output->getLvl();
+	}//: foreach
+	minimal_severity_level.store(min_lvl, boost::memory_order_relaxed);
+	LogSiteRegistry::setDefaultThreshold(min_lvl);
+}
+
+
+void severityLevelChanged() {
+	Logger::getInstance()->updateMinimalSeverityLevel();
 }
 
 
 void Logger::log(const std::string & file, int line, Severity_t sev, const std::string & msg) {
-	BOOST_FOREACH(LoggerOutput & output, outputs) {
-		if (sev < output.getLvl())
+	LogRecord rec;
+	rec.site = LogSiteRegistry::intern(file, line, sev).id;
+	rec.severity = sev;
+	rec.message = msg;
+	rec.timestamp = monotonicNs();
+	rec.thread = threadId();
+	log(rec);
+}
+
+
+void Logger::logBinary(const std::string & file, int line, Severity_t sev, const std::string & args) {
+	LogRecord rec;
+	rec.site = LogSiteRegistry::intern(file, line, sev).id;
+	rec.severity = sev;
+	rec.message = args;
+	rec.binary = true;
+	rec.timestamp = monotonicNs();
+	rec.thread = threadId();
+	log(rec);
+}
+
+
+void Logger::log(const LogRecord & rec_) {
+	// Coalesce the repeated records (when enabled) before they are queued or printed.
+	if ((duplicate_window.load(boost::memory_order_relaxed) > 0) && suppressDuplicate(rec_))
+		return;
+	submit(rec_);
+}
+
+
+void Logger::submit(const LogRecord & rec_) {
+	// Asynchronous mode - put the record into the queue (unless called by the flush thread itself).
+	if (!in_flush_thread) {
+		// Sequentially consistent - pairs with stopAsync(): either it sees this producer or the producer sees async off.
+		active_producers.fetch_add(1, boost::memory_order_seq_cst);
+		if (async.load(boost::memory_order_seq_cst)) {
+			RecordFiller filler(rec_);
+			while (!queue->tryPush(filler)) {
+				if (overflow_policy == DropNewest) {
+					dropped_records.fetch_add(1, boost::memory_order_relaxed);
+					active_producers.fetch_sub(1, boost::memory_order_release);
+					return;
+				} else if (overflow_policy == DropOldest) {
+					// Discard the oldest record.
+					static thread_local LogRecord discarded;
+					if (queue->tryPop(discarded)) {
+						dropped_records.fetch_add(1, boost::memory_order_relaxed);
+						popped_records.fetch_add(1, boost::memory_order_release);
+					}//: if
+				} else
+					boost::this_thread::yield();
+			}//: while
+			pushed_records.fetch_add(1, boost::memory_order_release);
+			active_producers.fetch_sub(1, boost::memory_order_release);
+			return;
+		}//: if
+		active_producers.fetch_sub(1, boost::memory_order_release);
+	}//: if
+
+	dispatch(rec_, true);
+}
+
+
+Logger::LastRecord & Logger::lastRecord(uint32_t site_) {
+	boost::atomic<LastRecord*> & slot = last_records[site_ >> last_records_chunk_bits];
+	LastRecord * chunk = slot.load(boost::memory_order_acquire);
+	if (!chunk) {
+		// Allocate the chunk - the thread that loses the race frees its own.
+		LastRecord * fresh = new LastRecord[1 << last_records_chunk_bits];
+		if (slot.compare_exchange_strong(chunk, fresh, boost::memory_order_acq_rel))
+			chunk = fresh;
+		else
+			delete[] fresh;
+	}//: if
+	return chunk[site_ & ((1 << last_records_chunk_bits) - 1)];
+}
+
+
+bool Logger::suppressDuplicate(const LogRecord & rec_) {
+	int64_t window = duplicate_window.load(boost::memory_order_relaxed);
+	if (window == 0)
+		return false;
+	LastRecord & last = lastRecord(rec_.site);
+	LogRecord summary;
+	size_t repeated = 0;
+	{
+		boost::lock_guard<LastRecord> guard(last);
+		int64_t now = monotonicNs();
+		bool same = (last.since != 0) && (last.severity == rec_.severity) && (last.binary == rec_.binary) && (last.message == rec_.message);
+		if (same && (now - last.since < window)) {
+			if (last.repeated++ == 0)
+				pending_duplicates.fetch_add(1, boost::memory_order_relaxed);
+			suppressed_records.fetch_add(1, boost::memory_order_relaxed);
+			return true;
+		}//: if
+
+		// Different record or expired window - summarize the previous one and start a new window.
+		repeated = last.repeated;
+		if (repeated > 0) {
+			fillRepeatSummary(summary, rec_.site, last.severity, repeated);
+			pending_duplicates.fetch_sub(1, boost::memory_order_relaxed);
+		}//: if
+		last.severity = rec_.severity;
+		last.binary = rec_.binary;
+		last.message = rec_.message;
+		last.since = now;
+		last.repeated = 0;
+	}
+	// Log outside of the lock - outputs might log too.
+	if (repeated > 0)
+		submit(summary);
+	return false;
+}
+
+
+void Logger::flushDuplicates(bool expired_only_) {
+	std::vector<LogRecord> summaries;
+	int64_t window = duplicate_window.load(boost::memory_order_relaxed);
+	int64_t now = monotonicNs();
+	uint32_t sites = LogSiteRegistry::size();
+	for (uint32_t c = 0; (c << last_records_chunk_bits) < sites; c++) {
+		LastRecord * chunk = last_records[c].load(boost::memory_order_acquire);
+		if (!chunk)
 			continue;
+		for (uint32_t i = 0; i < (1u << last_records_chunk_bits); i++) {
+			LastRecord & last = chunk[i];
+			boost::lock_guard<LastRecord> guard(last);
+			if ((last.repeated == 0) || (expired_only_ && (now - last.since < window)))
+				continue;
+			summaries.push_back(LogRecord());
+			fillRepeatSummary(summaries.back(), (c << last_records_chunk_bits) + i, last.severity, last.repeated);
+			last.repeated = 0;
+			pending_duplicates.fetch_sub(1, boost::memory_order_relaxed);
+			// Expired window is closed - the next record of the site is printed.
+			if (expired_only_)
+				last.since = 0;
+		}//: for
+	}//: for
+	for (size_t i = 0; i < summaries.size(); i++)
+		submit(summaries[i]);
+}
+
+
+void Logger::setDuplicateSuppression(unsigned int window_ms_) {
+	flushDuplicates();
+	duplicate_window.store((int64_t)window_ms_ * 1000000, boost::memory_order_relaxed);
+	// Close all windows.
+	for (uint32_t c = 0; c < last_records_max_chunks; c++) {
+		LastRecord * chunk = last_records[c].load(boost::memory_order_acquire);
+		for (uint32_t i = 0; chunk && (i < (1u << last_records_chunk_bits)); i++) {
+			boost::lock_guard<LastRecord> guard(chunk[i]);
+			chunk[i].since = 0;
+		}//: for
+	}//: for
+}
+
+
+size_t Logger::getSuppressedRecords() const {
+	return suppressed_records.load(boost::memory_order_relaxed);
+}
+
 
-		output.print(msg, sev, file, line);
+void Logger::dispatch(const LogRecord & rec_, bool end_of_batch_) {
+	const LogSite & site = LogSiteRegistry::get(rec_.site);
+	// Sites enabled by the dynamic debug rules (or levels of categories) bypass the levels of outputs accepting them.
+	bool forced = site.isForced();
+	// The text of binary records is formatted (at most) once, for all outputs.
+	RecordText::current().bind(rec_);
+	BOOST_FOREACH(LoggerOutput * output, currentOutputs()) {
+		if ((rec_.severity < output->getLvl()) && !(forced && output->acceptsForcedRecords()))
+			continue;
+
+		output->write(rec_, site);
+		if (end_of_batch_)
+			output->endOfBatch();
 	}
 }
 
 
+void Logger::flushOutputs() {
+	BOOST_FOREACH(LoggerOutput * output, currentOutputs())
+		output->flush();
+}
+
+
+void Logger::completeBatch() {
+	BOOST_FOREACH(LoggerOutput * output, currentOutputs())
+		output->endOfBatch();
+}
+
+
+void Logger::startAsync(size_t capacity_, OverflowPolicy_t policy_) {
+	boost::mutex::scoped_lock lock(async_mutex);
+	if (async.load())
+		return;
+
+	// Create the queue - or reuse the existing one if its capacity fits.
+	if (!queue || (queue->capacity() < capacity_))
+		queue.reset(new RingBuffer<LogRecord>(capacity_));
+	overflow_policy = policy_;
+
+	// Start the flush thread.
+	flush_thread_running.store(true);
+	flush_thread.reset(new boost::thread(&Logger::flushThreadMain, this));
+	async.store(true, boost::memory_order_release);
+}
+
+
+void Logger::stopAsync() {
+	boost::mutex::scoped_lock lock(async_mutex);
+	if (!async.load())
+		return;
+
+	// Stop accepting new records and wait for producers that are still pushing.
+	// (Sequentially consistent - acquire/release would not order the store before the load, see submit()).
+	async.store(false, boost::memory_order_seq_cst);
+	while (active_producers.load(boost::memory_order_seq_cst) > 0)
+		boost::this_thread::yield();
+
+	// Drain the queue and stop the flush thread.
+	flush_thread_running.store(false);
+	flush_thread->join();
+	flush_thread.reset();
+}
+
+
+bool Logger::isAsync() const {
+	return async.load(boost::memory_order_acquire);
+}
+
+
+void Logger::flush() {
+	// Print the pending summaries of repeated records first.
+	if (duplicate_window.load(boost::memory_order_relaxed) > 0)
+		flushDuplicates();
+	if (async.load(boost::memory_order_acquire) && !in_flush_thread) {
+		// Wait until the flush thread prints everything that was logged so far.
+		size_t target = pushed_records.load(boost::memory_order_acquire);
+		while ((popped_records.load(boost::memory_order_acquire) < target) && async.load(boost::memory_order_acquire))
+			boost::this_thread::sleep(boost::posix_time::microseconds(100));
+	}//: if
+	flushOutputs();
+}
+
+
+size_t Logger::getDroppedRecords() const {
+	return dropped_records.load(boost::memory_order_relaxed);
+}
+
+
+void Logger::flushThreadMain() {
+	in_flush_thread = true;
+	LogRecord rec;
+	int64_t last_duplicates_check = monotonicNs();
+	for(;;) {
+		// Summarize the repetitions of sites whose window expired - so the summaries of idle sites do not wait.
+		if (pending_duplicates.load(boost::memory_order_relaxed) > 0) {
+			int64_t now = monotonicNs();
+			if (now - last_duplicates_check >= duplicates_check_period) {
+				flushDuplicates(true);
+				last_duplicates_check = now;
+			}//: if
+		}//: if
+
+		// Print a batch of records.
+		size_t n = 0;
+		while ((n < flush_batch_size) && queue->tryPop(rec)) {
+			dispatch(rec, false);
+			n++;
+		}//: while
+
+		if (n > 0) {
+			// Inform outputs about the end of batch (e.g. console is flushed once per batch).
+			completeBatch();
+			popped_records.fetch_add(n, boost::memory_order_release);
+			continue;
+		}//: if
+
+		// Queue empty - finish if stopped.
+		if (!flush_thread_running.load())
+			break;
+		boost::this_thread::sleep(boost::posix_time::microseconds(200));
+	}//: for
+}
+
+
 
 void Logger::incrementSeverityLevel() {
-	BOOST_FOREACH(LoggerOutput & output, outputs)
-		output.incrementLvl();
+	BOOST_FOREACH(LoggerOutput * output, currentOutputs())
+		output->incrementLvl();
 }
 
 void Logger::decrementSeverityLevel() {
-	BOOST_FOREACH(LoggerOutput & output, outputs)
-		output.decrementLvl();
+	BOOST_FOREACH(LoggerOutput * output, currentOutputs())
+		output->decrementLvl();
 }
 
 
 void Logger::setSeverityLevel(Severity_t sev) {
-	BOOST_FOREACH(LoggerOutput & output, outputs)
-		output.setLvl(sev);
+	BOOST_FOREACH(LoggerOutput * output, currentOutputs())
+		output->setLvl(sev);
 }
 
 
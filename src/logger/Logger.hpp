@@ -25,10 +25,16 @@
 
 #include <boost/atomic.hpp>
 #include <boost/thread/mutex.hpp>
+#include <boost/thread/thread.hpp>
+#include <boost/scoped_ptr.hpp>
 #include <boost/ptr_container/ptr_vector.hpp>
+#include <boost/scoped_array.hpp>
 
+#include <vector>
 
 #include <logger/LoggerOutput.hpp>
+#include <logger/LogRecord.hpp>
+#include <logger/RingBuffer.hpp>
 
 
 namespace mic {
@@ -40,6 +46,17 @@ namespace mic {
  */
 namespace logger {
 
+/*!
+ * \brief Policy applied by the asynchronous logger when its queue is full.
+ * \author tkornuta
+ */
+enum OverflowPolicy_t
+{
+	BlockOnOverflow = 0, ///< Producer waits until the flush thread frees a cell - no record is lost.
+	DropNewest, ///< The record that does not fit is discarded.
+	DropOldest ///< The oldest record waiting in the queue is discarded to make space for the new one.
+};
+
 /*!
  * \brief Logger - defined in the form of a singleton, with double-checked locking pattern (DCLP) based access to instance.
  * \author tkornuta
@@ -52,11 +69,36 @@ public:
 	 */
 	static Logger* getInstance();
 
+	/*!
+	 * Checks whether a message of given severity will be printed by any output - costs a single relaxed atomic load.
+	 * @param sev_ Message severity.
+	 * @return True if at least one output accepts messages of a given severity.
+	 */
+	static bool isEnabled(Severity_t sev_) {
+		return (int)sev_ >= minimal_severity_level.load(boost::memory_order_relaxed);
+	}
+
+	/*!
+	 * Recomputes the cached minimal severity level accepted by the outputs. Called when the level of any output changes.
+	 */
+	void updateMinimalSeverityLevel();
+
+	/*!
+	 * Logs the record - sends it to registered logger outputs (or puts it into the queue in asynchronous mode).
+	 */
+	void log(const LogRecord & rec_);
+
 	/*!
 	 * Logs the message - sends it to registered logger outputs.
+	 * The call site is looked up by file and line (slower than the LOG macro, which registers its site once).
 	 */
 	void log(const std::string & file, int line, Severity_t sev, const std::string & msg);
 
+	/*!
+	 * Logs the message captured in binary form - sends it to registered logger outputs.
+	 */
+	void logBinary(const std::string & file, int line, Severity_t sev, const std::string & args);
+
 	/*!
 	 * Adds logger output.
 	 */
@@ -78,6 +120,50 @@ public:
 	 */
 	void setSeverityLevel(Severity_t sev);
 
+	/*!
+	 * Switches the logger to asynchronous mode: records are put into a bounded lock-free queue and printed by a dedicated flush thread.
+	 * The queue is drained and the thread is stopped at exit (or when stopAsync() is called).
+	 * Outputs are informed about the end of each batch of records (instead of the end of each record).
+	 * @param capacity_ Capacity of the queue (rounded up to the power of two).
+	 * @param policy_ Policy applied when the queue is full.
+	 */
+	void startAsync(size_t capacity_ = 8192, OverflowPolicy_t policy_ = BlockOnOverflow);
+
+	/*!
+	 * Drains the queue, stops the flush thread and switches the logger back to synchronous mode. Called at exit.
+	 */
+	void stopAsync();
+
+	/*!
+	 * Returns true if the logger works in asynchronous mode.
+	 */
+	bool isAsync() const;
+
+	/*!
+	 * Waits until all records logged so far are printed by all outputs, then flushes the outputs.
+	 */
+	void flush();
+
+	/*!
+	 * Returns the number of records dropped due to the overflow of the asynchronous queue.
+	 */
+	size_t getDroppedRecords() const;
+
+	/*!
+	 * Sets the window of suppression of duplicates: identical consecutive records of the same call site logged within the window
+	 * (measured from the first of them) are not printed, instead a single "last message repeated N times" record is logged
+	 * when a different record comes from the site, when the record is repeated after the window expired or when the logger is flushed.
+	 * In asynchronous mode the flush thread also logs the summaries of sites whose window expired, so summaries of idle sites do not wait.
+	 * The last record of every site is guarded by its own spin lock - different sites do not contend.
+	 * @param window_ms_ Window in ms (0 - suppression disabled, default).
+	 */
+	void setDuplicateSuppression(unsigned int window_ms_);
+
+	/*!
+	 * Returns the number of records suppressed as duplicates.
+	 */
+	size_t getSuppressedRecords() const;
+
 
 private:
     /*!
@@ -90,16 +176,197 @@ private:
 	 */
 	static boost::mutex instantiation_mutex;
 
+	/*!
+	 * Minimal severity level accepted by any output, cached for the LOG macro (above Fatal when there are no outputs).
+	 */
+	static boost::atomic<int> minimal_severity_level;
+
 	/*!
 	 * Private constructor.
 	 */
 	Logger();
 
 	/*!
-	 * List of outputs.
+	 * Mutex used for modification of the list of outputs.
+	 */
+	boost::mutex outputs_mutex;
+
+	/// Immutable list of outputs (snapshot) - read without locking.
+	typedef std::vector<LoggerOutput*> OutputList;
+
+	/*!
+	 * Returns the current list of outputs - costs a single atomic load.
+	 */
+	const OutputList & currentOutputs() const {
+		return *output_snapshot.load(boost::memory_order_acquire);
+	}
+
+	/*!
+	 * Puts the record into the queue (in asynchronous mode) or passes it to the outputs.
+	 */
+	void submit(const LogRecord & rec_);
+
+	/*!
+	 * Checks whether the record repeats the last record of its site - if so, counts it.
+	 * Otherwise remembers the record, logging the summary of repetitions of the previous one (if any).
+	 * @return True if the record is a duplicate and should not be printed.
+	 */
+	bool suppressDuplicate(const LogRecord & rec_);
+
+	/*!
+	 * Logs the summaries of pending repetitions.
+	 * @param expired_only_ If true, only the summaries of sites whose window expired are logged (and their windows are closed).
+	 */
+	void flushDuplicates(bool expired_only_ = false);
+
+	/// Last record of a site.
+	struct LastRecord;
+
+	/*!
+	 * Returns the last record of the site - allocates the chunk of last records on demand.
+	 * @param site_ Id of the site.
+	 */
+	LastRecord & lastRecord(uint32_t site_);
+
+	/*!
+	 * Passes the record to all outputs.
+	 * @param rec_ Record.
+	 * @param end_of_batch_ If true, the outputs are informed about the end of batch after the record (synchronous mode).
+	 */
+	void dispatch(const LogRecord & rec_, bool end_of_batch_);
+
+	/*!
+	 * Flushes all outputs.
+	 */
+	void flushOutputs();
+
+	/*!
+	 * Informs all outputs about the end of batch of records.
+	 */
+	void completeBatch();
+
+	/*!
+	 * Main function of the flush thread - drains the queue until stopped.
+	 */
+	void flushThreadMain();
+
+	/*!
+	 * List of outputs - owns the outputs, modified only under outputs_mutex.
 	 */
 	boost::ptr_vector<LoggerOutput> outputs;
 
+	/*!
+	 * Current snapshot of the list of outputs, read by the logging threads.
+	 * Writers (under outputs_mutex) copy the current list, modify the copy and publish it with a single atomic store.
+	 */
+	boost::atomic<const OutputList*> output_snapshot;
+
+	/*!
+	 * All published snapshots. Retired snapshots are never freed, as a logging thread might still be iterating over them
+	 * (outputs are only added, so there are as many snapshots as calls of addOutput).
+	 */
+	boost::ptr_vector<OutputList> snapshots;
+
+	/*!
+	 * Flag denoting whether the logger works in asynchronous mode.
+	 */
+	boost::atomic<bool> async;
+
+	/*!
+	 * Flag used for stopping the flush thread.
+	 */
+	boost::atomic<bool> flush_thread_running;
+
+	/*!
+	 * Queue of records waiting for the flush thread.
+	 */
+	boost::scoped_ptr< RingBuffer<LogRecord> > queue;
+
+	/*!
+	 * Policy applied when the queue is full.
+	 */
+	OverflowPolicy_t overflow_policy;
+
+	/*!
+	 * Flush thread - prints the records stored in the queue.
+	 */
+	boost::scoped_ptr<boost::thread> flush_thread;
+
+	/*!
+	 * Mutex used for starting/stopping the asynchronous mode.
+	 */
+	boost::mutex async_mutex;
+
+	/// Number of producers that are currently logging (used for safe stopping of the asynchronous mode).
+	boost::atomic<size_t> active_producers;
+
+	/// Number of records put into the queue.
+	boost::atomic<size_t> pushed_records;
+
+	/// Number of records taken from the queue (printed or dropped).
+	boost::atomic<size_t> popped_records;
+
+	/// Number of dropped records.
+	boost::atomic<size_t> dropped_records;
+
+	/*!
+	 * \brief Last record of a site, remembered for the suppression of duplicates - guarded by its own spin lock (lock() and unlock()).
+	 */
+	struct LastRecord {
+		/// Flag of the spin lock.
+		boost::atomic<bool> locked;
+
+		/// Severity of the record.
+		Severity_t severity;
+
+		/// Flag denoting whether the message contains binary arguments.
+		bool binary;
+
+		/// Message contents.
+		std::string message;
+
+		/// Time at which the record was printed (beginning of the window).
+		int64_t since;
+
+		/// Number of suppressed repetitions.
+		size_t repeated;
+
+		LastRecord() : locked(false), severity(Trace), binary(false), since(0), repeated(0) { }
+
+		/*!
+		 * Acquires the spin lock.
+		 */
+		void lock() {
+			while (locked.exchange(true, boost::memory_order_acquire))
+				boost::this_thread::yield();
+		}
+
+		/*!
+		 * Releases the spin lock.
+		 */
+		void unlock() {
+			locked.store(false, boost::memory_order_release);
+		}
+	};
+
+	/// Number of bits of the site id within the chunk of last records.
+	static const uint32_t last_records_chunk_bits = 8;
+
+	/// Maximal number of chunks of last records (as many as there can be sites, see LogSiteRegistry).
+	static const uint32_t last_records_max_chunks = 4096;
+
+	/// Window of suppression of duplicates in ns (0 - disabled).
+	boost::atomic<int64_t> duplicate_window;
+
+	/// Chunks of last records of sites (indexed by the site id) - allocated on demand and never freed.
+	boost::scoped_array<boost::atomic<LastRecord*> > last_records;
+
+	/// Number of sites with pending (not yet summarized) repetitions.
+	boost::atomic<size_t> pending_duplicates;
+
+	/// Number of records suppressed as duplicates.
+	boost::atomic<size_t> suppressed_records;
+
 };
 
 
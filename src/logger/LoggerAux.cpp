@@ -22,6 +22,8 @@
 
 #include <logger/LoggerAux.hpp>
 
+#include <cctype>
+
 
 namespace mic {
 namespace logger {
@@ -51,5 +53,27 @@ std::string sev2str(Severity_t sev_)
 }
 
 
+bool str2sev(const std::string & str_, Severity_t & sev_)
+{
+	// Number of the level.
+	if ((str_.size() == 1) && (str_[0] >= '0') && (str_[0] <= '0' + Fatal)) {
+		sev_ = (Severity_t)(str_[0] - '0');
+		return true;
+	}//: if
+
+	// Name of the level.
+	std::string upper(str_);
+	for (size_t i = 0; i < upper.size(); i++)
+		upper[i] = std::toupper(upper[i]);
+	for (int i = Trace; i <= Fatal; i++) {
+		if (upper == sev2str((Severity_t)i)) {
+			sev_ = (Severity_t)i;
+			return true;
+		}//: if
+	}//: for
+	return false;
+}
+
+
 } /* namespace logger */
 } /* namespace mic */
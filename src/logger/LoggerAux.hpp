@@ -25,6 +25,21 @@
 
 #include <string>
 
+/*!
+ * \brief Minimal severity level of messages compiled into the binary (0 - TRACE, ..., 7 - FATAL).
+ * LOG statements below this level are turned into dead code, so they leave no instructions nor strings in optimized builds.
+ * Set by the MIC_LOG_COMPILE_LEVEL cmake option, can be raised for a single translation unit (defined before including the logger headers).
+ */
+#ifndef MIC_LOG_COMPILE_LEVEL
+#define MIC_LOG_COMPILE_LEVEL 0
+#endif
+
+/*!
+ * \brief Checks whether messages of given severity are compiled into the current translation unit.
+ * A macro (unlike isCompiledIn()), so every translation unit uses its own MIC_LOG_COMPILE_LEVEL - used by the LOG/CHECK macros.
+ */
+#define MIC_LOG_COMPILED_IN(level) ((int)(level) >= MIC_LOG_COMPILE_LEVEL)
+
 namespace mic {
 namespace logger {
 
@@ -49,6 +64,24 @@ enum Severity_t
  */
 std::string sev2str(Severity_t sev_);
 
+/*!
+ * Converts the string (name of the level, e.g. "DEBUG" or "debug", or its number) into the severity level.
+ * @param str_ String.
+ * @param sev_ Returned severity level.
+ * @return False if the string does not represent any severity level.
+ */
+bool str2sev(const std::string & str_, Severity_t & sev_);
+
+/*!
+ * Checks whether messages of given severity are compiled into the binary (with the level the logger library was built with) -
+ * evaluated at compile time for constant levels.
+ * @param sev_ Message severity.
+ * @return True if severity is not lower than MIC_LOG_COMPILE_LEVEL.
+ */
+constexpr bool isCompiledIn(Severity_t sev_) {
+	return (int)sev_ >= MIC_LOG_COMPILE_LEVEL;
+}
+
 #define LTRACE    mic::logger::Trace
 #define LDEBUG    mic::logger::Debug
 #define LNOTICE     mic::logger::Notice
@@ -0,0 +1,101 @@
+/*!
+ * Copyright (C) tkornuta, IBM Corporation 2015-2019
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+/*!
+ * \file LoggerCompileLevelTests.cpp
+ * \brief Contains the tests of the compile-time level of the logger - this translation unit is compiled with MIC_LOG_COMPILE_LEVEL of WARNING.
+ * \author tkornuta
+ * \date Oct 17, 2026
+ */
+
+// Raise the compile level for this translation unit only (the global one is set by cmake).
+#undef MIC_LOG_COMPILE_LEVEL
+#define MIC_LOG_COMPILE_LEVEL 5
+
+#include <gtest/gtest.h>
+
+#include <vector>
+#include <string>
+
+#include <boost/thread/mutex.hpp>
+
+#include <logger/Log.hpp>
+
+using namespace mic::logger;
+
+namespace {
+
+/*!
+ * Output storing the messages - accepts all severities, so only the compile level can stop the messages.
+ */
+class CountingOutput : public LoggerOutput {
+public:
+	CountingOutput() : LoggerOutput(LTRACE) { }
+
+	void print(const std::string & msg_, Severity_t, const std::string &, int) const {
+		boost::mutex::scoped_lock lock(mutex);
+		messages.push_back(msg_);
+	}
+
+	std::vector<std::string> get() const {
+		boost::mutex::scoped_lock lock(mutex);
+		return messages;
+	}
+
+private:
+	mutable boost::mutex mutex;
+	mutable std::vector<std::string> messages;
+};
+
+/*!
+ * Increments the counter - shows whether the argument of the statement was evaluated.
+ */
+int evaluate(int & counter_) {
+	return ++counter_;
+}
+
+}//: namespace
+
+
+/*!
+ * Tests whether statements below MIC_LOG_COMPILE_LEVEL are stripped - their stream expressions are never evaluated,
+ * even when the outputs and dynamic debug rules would accept them.
+ */
+TEST(Logger, CompileLevelStripsStatements) {
+	CountingOutput* out = new CountingOutput();
+	LOGGER->addOutput(out);
+	LogSiteRegistry::setDynamicDebug("LoggerCompileLevelTests.cpp:*");
+
+	int evaluated = 0;
+	LOG(LTRACE) << evaluate(evaluated);
+	LOG(LINFO) << evaluate(evaluated);
+	LOG(LSTATUS) << evaluate(evaluated);
+	BLOG(LDEBUG) << evaluate(evaluated);
+	LOGF(LNOTICE, "{}", evaluate(evaluated));
+	LOG_KV(LINFO, "event", "value", evaluate(evaluated));
+	LOG_EVERY_N(LINFO, 1) << evaluate(evaluated);
+	EXPECT_EQ(evaluated, 0);
+
+	LOG(LWARNING) << "compiled " << evaluate(evaluated);
+	LOG(LERROR) << "compiled " << evaluate(evaluated);
+	EXPECT_EQ(evaluated, 2);
+	LogSiteRegistry::setDynamicDebug("");
+
+	std::vector<std::string> msgs = out->get();
+	ASSERT_EQ(msgs.size(), 2u);
+	EXPECT_EQ(msgs[0], "compiled 1");
+	EXPECT_EQ(msgs[1], "compiled 2");
+	out->setLvl(LFATAL);
+}
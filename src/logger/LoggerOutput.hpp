@@ -24,11 +24,85 @@
 #define SRC_CONFIGURATION_LOGGEROUTPUT_HPP_
 
 #include <logger/LoggerAux.hpp>
+#include <logger/BinaryFormat.hpp>
+#include <logger/LogRecord.hpp>
+#include <logger/LogStream.hpp>
+
+#include <boost/atomic.hpp>
 
 
 namespace mic {
 namespace logger {
 
+/*!
+ * Informs the logger that the severity level of one of the outputs has changed (so it can update its cached minimal level).
+ */
+void severityLevelChanged();
+
+/*!
+ * \class RecordText
+ * \brief Text of the message of the record dispatched by the calling thread.
+ * Binary records are formatted lazily - once per record, shared by all text outputs - into memory kept between records,
+ * so in steady state no memory is allocated. The logger binds every dispatched record (see bind()), outputs read the text with get().
+ */
+class RecordText {
+public:
+	/*!
+	 * Returns the instance of the calling thread.
+	 */
+	static RecordText & current() {
+		static thread_local RecordText instance;
+		return instance;
+	}
+
+	/*!
+	 * Binds the record - its text will be formatted on the first use.
+	 * @param rec_ Record.
+	 */
+	void bind(const LogRecord & rec_) {
+		rec = &rec_;
+		formatted = false;
+	}
+
+	/*!
+	 * Returns the text of the message of the record.
+	 * @param rec_ Record (if it is not the bound one, it is bound first).
+	 */
+	const std::string & get(const LogRecord & rec_) {
+		if (!rec_.binary)
+			return rec_.message;
+		if (rec != &rec_)
+			bind(rec_);
+		if (!formatted) {
+			buf.reset();
+			if (!binary::formatArguments(rec_.message.data(), rec_.message.size(), stream))
+				stream << " <corrupted binary arguments>";
+			text.assign(buf.data(), buf.size());
+			formatted = true;
+		}//: if
+		return text;
+	}
+
+private:
+	RecordText() : rec(NULL), formatted(false), stream(&buf) { }
+
+	/// Bound record.
+	const LogRecord * rec;
+
+	/// Flag denoting whether the text of the bound record is formatted.
+	bool formatted;
+
+	/// Buffer used for formatting.
+	LogStreamBuf buf;
+
+	/// Stream writing into the buffer.
+	std::ostream stream;
+
+	/// Formatted text.
+	std::string text;
+};
+
+
 /*!
  * \class LoggerOutput
  * \brief Abstract interface for different logger outputs.
@@ -39,7 +113,7 @@ public:
 	 * Constructor. Sets default severity level (LINFO as default).
 	 * @param sev Default output severity level.
 	 */
-	LoggerOutput(Severity_t sev = LINFO) : lvl(sev)
+	LoggerOutput(Severity_t sev = LINFO) : lvl(sev), timestamps(false), forced_records(false)
 	{
 
 	}
@@ -61,28 +135,72 @@ public:
 	 */
 	virtual void print(const std::string & msg_, Severity_t severity_, const std::string & file_, int line_) const = 0;
 
+	/*!
+	 * \brief Logs message captured in binary form (see BinaryScopeLogger).
+	 * By default the arguments are formatted as text and passed to print(), outputs storing binary logs override it.
+	 * Not used by the default write() - which passes the text shared by all outputs (see RecordText) to print().
+	 *
+	 * \param args_ Binary arguments of the message
+	 * \param severity_ Severity of message
+	 * \param file_ Name of file, from which log was called
+	 * \param line_ Number of line, from which log was called
+	 */
+	virtual void printBinary(const std::string & args_, Severity_t severity_, const std::string & file_, int line_) const {
+		print(binary::formatArguments(args_), severity_, file_, line_);
+	}
+
+	/*!
+	 * \brief Logs the record - called by the logger for every record accepted by the output.
+	 * By default passes the text of the message (binary records formatted once for all outputs, see RecordText) to print(),
+	 * outputs that use the site id or keep the binary arguments override it.
+	 *
+	 * \param rec_ Record
+	 * \param site_ Call site of the record
+	 */
+	virtual void write(const LogRecord & rec_, const LogSite & site_) const {
+		print(RecordText::current().get(rec_), rec_.severity, site_.file_name, site_.line);
+	}
+
+	/*!
+	 * \brief Flushes the printed messages - everything printed so far must be written.
+	 * Called when the logger is flushed (e.g. when application quits and at exit). Empty by default.
+	 */
+	virtual void flush() { }
+
+	/*!
+	 * \brief Informs the output about the end of batch of messages.
+	 * Called after every message in synchronous mode and after every batch of messages in asynchronous mode.
+	 * Flushes the output by default, buffered outputs can override it and write the data only when necessary.
+	 */
+	virtual void endOfBatch() {
+		flush();
+	}
+
 	/*!
 	 * Sets severity level.
 	 * @param sev Severity level.
 	 */
 	void setLvl(Severity_t sev) {
-		lvl = sev;
+		lvl.store(sev, boost::memory_order_relaxed);
+		severityLevelChanged();
 	}
 
 	/*!
 	 * Increments severity level.
 	 */
 	void incrementLvl() {
-		if (lvl < LFATAL)
-			lvl = (Severity_t)(lvl+1);
+		Severity_t cur = lvl.load(boost::memory_order_relaxed);
+		while ((cur < LFATAL) && !lvl.compare_exchange_weak(cur, (Severity_t)(cur+1), boost::memory_order_relaxed));
+		severityLevelChanged();
 	}
 
 	/*!
 	 * Decrements severity level.
 	 */
 	void decrementLvl() {
-		if (lvl > LTRACE)
-			lvl = (Severity_t)(lvl-1);
+		Severity_t cur = lvl.load(boost::memory_order_relaxed);
+		while ((cur > LTRACE) && !lvl.compare_exchange_weak(cur, (Severity_t)(cur-1), boost::memory_order_relaxed));
+		severityLevelChanged();
 	}
 
 
@@ -91,14 +209,81 @@ public:
 	 * @return Severity level
 	 */
 	Severity_t getLvl() const {
-		return lvl;
+		return lvl.load(boost::memory_order_relaxed);
+	}
+
+	/*!
+	 * Enables/disables prefixing of messages with the time and thread id (in outputs that support it).
+	 * @param timestamps_ True - messages are prefixed.
+	 */
+	void setTimestamps(bool timestamps_) {
+		timestamps.store(timestamps_, boost::memory_order_relaxed);
+	}
+
+	/*!
+	 * Returns true if messages are prefixed with the time and thread id.
+	 */
+	bool getTimestamps() const {
+		return timestamps.load(boost::memory_order_relaxed);
+	}
+
+	/*!
+	 * Enables/disables accepting of forced records - messages of sites enabled by the dynamic debug rules or by levels of their categories
+	 * (see LogSite::isForced()) are then printed regardless of the level of the output. Disabled by default, so e.g. a category set to DEBUG
+	 * does not flood files or other outputs muted to higher levels - ConsoleOutput enables it in its constructor.
+	 * @param forced_records_ True - forced records bypass the level of the output.
+	 */
+	void setForcedRecords(bool forced_records_) {
+		forced_records.store(forced_records_, boost::memory_order_relaxed);
+	}
+
+	/*!
+	 * Returns true if forced records bypass the level of the output.
+	 */
+	bool acceptsForcedRecords() const {
+		return forced_records.load(boost::memory_order_relaxed);
 	}
 
 protected:
 	/*!
 	 * Logger severity - messages below this level will not be printed.
+	 * Atomic, as it can be changed (e.g. by key handlers) while other threads are logging.
+	 */
+	boost::atomic<Severity_t> lvl;
+
+	/// Flag denoting whether messages are prefixed with the time and thread id.
+	boost::atomic<bool> timestamps;
+
+	/// Flag denoting whether forced records bypass the level of the output.
+	boost::atomic<bool> forced_records;
+
+	/// Maximal length of the prefix (with the terminating zero).
+	static const size_t prefix_length = timestamp_length + 16;
+
+	/*!
+	 * Formats the prefix of the record - "YYYY-MM-DD HH:MM:SS.mmm #thread ".
+	 * @param rec_ Record.
+	 * @param buf_ Output buffer of (at least) prefix_length characters.
+	 * @return Length of the prefix.
 	 */
-	Severity_t lvl;
+	static size_t formatPrefix(const LogRecord & rec_, char * buf_) {
+		size_t len = formatTimestamp(rec_.timestamp, buf_);
+		buf_[len++] = ' ';
+		buf_[len++] = '#';
+		// Thread id - digits in reverse order.
+		char digits[10];
+		int n = 0;
+		uint32_t id = rec_.thread;
+		do {
+			digits[n++] = (char)('0' + id % 10);
+			id /= 10;
+		} while (id > 0);
+		while (n > 0)
+			buf_[len++] = digits[--n];
+		buf_[len++] = ' ';
+		buf_[len] = '\0';
+		return len;
+	}
 };
 
 
@@ -0,0 +1,1203 @@
+/*!
+ * Copyright (C) tkornuta, IBM Corporation 2015-2019
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+/*!
+ * @file: LoggerTests.cpp
+ * @Author: Tomasz Kornuta <tkornut@us.ibm.com>
+ * @Date:   Oct 17, 2026
+ */
+
+#include <gtest/gtest.h>
+
+#include <vector>
+#include <string>
+
+#include <boost/thread/thread.hpp>
+#include <boost/lexical_cast.hpp>
+
+#include <logger/Log.hpp>
+#include <logger/ConsoleOutput.hpp>
+#include <logger/FileOutput.hpp>
+#include <logger/FlightRecorderOutput.hpp>
+#include <logger/SharedMemoryOutput.hpp>
+#include <logger/JsonLinesOutput.hpp>
+#include <logger/NumberFormat.hpp>
+#ifdef MIC_HAVE_ZLIB
+#include <logger/CompressedFileOutput.hpp>
+#include <zlib.h>
+#endif
+
+#include <fstream>
+#include <iomanip>
+#include <sstream>
+#include <cstdio>
+#include <cstdlib>
+#include <cmath>
+#include <limits>
+
+#include <stdexcept>
+
+#include <dirent.h>
+#include <fcntl.h>
+#include <unistd.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <sys/wait.h>
+
+using namespace mic::logger;
+
+/*!
+ * Logger output storing the messages in a vector. Optionally blocks in print until the gate is opened.
+ */
+class CaptureOutput : public LoggerOutput {
+public:
+	CaptureOutput(Severity_t sev_ = LTRACE, bool closed_ = false) : LoggerOutput(sev_), gate_open(!closed_) { }
+
+	void print(const std::string & msg_, Severity_t, const std::string &, int) const {
+		while (!gate_open.load())
+			boost::this_thread::yield();
+		boost::mutex::scoped_lock lock(mutex);
+		messages.push_back(msg_);
+	}
+
+	void open() { gate_open.store(true); }
+
+	std::vector<std::string> get() const {
+		boost::mutex::scoped_lock lock(mutex);
+		return messages;
+	}
+
+private:
+	mutable boost::mutex mutex;
+	mutable std::vector<std::string> messages;
+	boost::atomic<bool> gate_open;
+};
+
+
+/*!
+ * Tests whether asynchronous logger prints all records in order after flush.
+ */
+TEST(Logger, AsyncKeepsOrder) {
+	CaptureOutput* out = new CaptureOutput();
+	LOGGER->addOutput(out);
+
+	LOGGER->startAsync(16, BlockOnOverflow);
+	ASSERT_TRUE(LOGGER->isAsync());
+	for (int i = 0; i < 1000; i++)
+		LOG(LINFO) << i;
+	LOGGER->flush();
+	LOGGER->stopAsync();
+	ASSERT_FALSE(LOGGER->isAsync());
+
+	std::vector<std::string> msgs = out->get();
+	ASSERT_EQ(msgs.size(), 1000u);
+	for (int i = 0; i < 1000; i++)
+		EXPECT_EQ(msgs[i], boost::lexical_cast<std::string>(i));
+	out->setLvl(LFATAL);
+}
+
+
+/*!
+ * Tests whether identical consecutive records of a site are coalesced into a summary.
+ */
+TEST(Logger, DuplicateSuppression) {
+	CaptureOutput* out = new CaptureOutput(LINFO);
+	LOGGER->addOutput(out);
+
+	LOGGER->setDuplicateSuppression(60000);
+	size_t suppressed_before = LOGGER->getSuppressedRecords();
+	for (int i = 0; i < 101; i++)
+		LOG(LINFO) << ((i < 100) ? "same" : "other");
+	LOG(LINFO) << "another site";
+	for (int i = 0; i < 5; i++)
+		LOG(LINFO) << "again";
+	LOGGER->flush();
+	LOGGER->setDuplicateSuppression(0);
+	for (int i = 0; i < 2; i++)
+		LOG(LINFO) << "not suppressed";
+
+	std::vector<std::string> msgs = out->get();
+	ASSERT_EQ(msgs.size(), 8u);
+	EXPECT_EQ(msgs[0], "same");
+	EXPECT_EQ(msgs[1], "last message repeated 99 times");
+	EXPECT_EQ(msgs[2], "other");
+	EXPECT_EQ(msgs[3], "another site");
+	EXPECT_EQ(msgs[4], "again");
+	EXPECT_EQ(msgs[5], "last message repeated 4 times");
+	EXPECT_EQ(msgs[6], "not suppressed");
+	EXPECT_EQ(msgs[7], "not suppressed");
+	EXPECT_EQ(LOGGER->getSuppressedRecords() - suppressed_before, 99u + 4u);
+	out->setLvl(LFATAL);
+}
+
+
+/*!
+ * Tests whether the flush thread summarizes repetitions of an idle site once its window expired.
+ */
+TEST(Logger, DuplicateSummaryOfIdleSite) {
+	CaptureOutput* out = new CaptureOutput(LINFO);
+	LOGGER->addOutput(out);
+
+	LOGGER->startAsync(8, BlockOnOverflow);
+	LOGGER->setDuplicateSuppression(20);
+	for (int i = 0; i < 5; i++)
+		LOG(LINFO) << "idle";
+	// No flush - the summary must be logged by the flush thread.
+	std::vector<std::string> msgs;
+	for (int i = 0; (i < 100) && (msgs.size() < 2); i++) {
+		boost::this_thread::sleep(boost::posix_time::milliseconds(10));
+		msgs = out->get();
+	}//: for
+	LOGGER->stopAsync();
+	LOGGER->setDuplicateSuppression(0);
+
+	ASSERT_EQ(msgs.size(), 2u);
+	EXPECT_EQ(msgs[0], "idle");
+	EXPECT_EQ(msgs[1], "last message repeated 4 times");
+	out->setLvl(LFATAL);
+}
+
+
+/*!
+ * Tests whether blocking policy does not lose records logged by many threads.
+ */
+TEST(Logger, AsyncBlockingFromManyThreads) {
+	CaptureOutput* out = new CaptureOutput();
+	LOGGER->addOutput(out);
+
+	struct Producer {
+		void operator()() {
+			for (int i = 0; i < 500; i++)
+				LOG(LINFO) << "msg";
+		}
+	};
+
+	LOGGER->startAsync(8, BlockOnOverflow);
+	boost::thread_group threads;
+	for (int t = 0; t < 4; t++)
+		threads.create_thread(Producer());
+	threads.join_all();
+	LOGGER->stopAsync();
+
+	ASSERT_EQ(out->get().size(), 2000u);
+	out->setLvl(LFATAL);
+}
+
+
+/*!
+ * Tests whether stopping the asynchronous mode while producers are still logging loses no record.
+ */
+TEST(Logger, StopAsyncWhileLogging) {
+	CaptureOutput* out = new CaptureOutput();
+	LOGGER->addOutput(out);
+
+	struct Producer {
+		void operator()() {
+			for (int i = 0; i < 5000; i++)
+				LOG(LINFO) << "msg";
+		}
+	};
+
+	for (int round = 0; round < 10; round++) {
+		LOGGER->startAsync(64, BlockOnOverflow);
+		boost::thread_group threads;
+		for (int t = 0; t < 4; t++)
+			threads.create_thread(Producer());
+		// Stop in the middle of logging - the remaining records are printed synchronously.
+		boost::this_thread::sleep(boost::posix_time::microseconds(500));
+		LOGGER->stopAsync();
+		threads.join_all();
+	}//: for
+
+	ASSERT_EQ(out->get().size(), 10u * 4u * 5000u);
+	out->setLvl(LFATAL);
+}
+
+
+/*!
+ * Tests whether the drop-newest policy counts the dropped records.
+ */
+TEST(Logger, AsyncDropNewest) {
+	CaptureOutput* out = new CaptureOutput(LTRACE, true);
+	LOGGER->addOutput(out);
+	size_t dropped_before = LOGGER->getDroppedRecords();
+
+	LOGGER->startAsync(4, DropNewest);
+	for (int i = 0; i < 100; i++)
+		LOG(LINFO) << i;
+	out->open();
+	LOGGER->stopAsync();
+
+	size_t dropped = LOGGER->getDroppedRecords() - dropped_before;
+	EXPECT_GT(dropped, 0u);
+	EXPECT_EQ(out->get().size() + dropped, 100u);
+	// The first record must survive.
+	EXPECT_EQ(out->get().front(), "0");
+	out->setLvl(LFATAL);
+}
+
+
+/*!
+ * Tests whether the drop-oldest policy keeps the most recent records.
+ */
+TEST(Logger, AsyncDropOldest) {
+	CaptureOutput* out = new CaptureOutput(LTRACE, true);
+	LOGGER->addOutput(out);
+	size_t dropped_before = LOGGER->getDroppedRecords();
+
+	LOGGER->startAsync(4, DropOldest);
+	for (int i = 0; i < 100; i++)
+		LOG(LINFO) << i;
+	out->open();
+	LOGGER->stopAsync();
+
+	size_t dropped = LOGGER->getDroppedRecords() - dropped_before;
+	EXPECT_GT(dropped, 0u);
+	EXPECT_EQ(out->get().size() + dropped, 100u);
+	// The last record must survive.
+	EXPECT_EQ(out->get().back(), "99");
+	out->setLvl(LFATAL);
+}
+
+
+/*!
+ * Tests whether outputs can be added and their levels changed while other threads are logging.
+ */
+TEST(Logger, AddOutputWhileLogging) {
+	CaptureOutput* first = new CaptureOutput();
+	LOGGER->addOutput(first);
+
+	boost::atomic<bool> running(true);
+	struct Producer {
+		boost::atomic<bool> & running;
+		Producer(boost::atomic<bool> & running_) : running(running_) { }
+		void operator()() {
+			while (running.load())
+				LOG(LINFO) << "msg";
+		}
+	};
+
+	boost::thread_group threads;
+	for (int t = 0; t < 4; t++)
+		threads.create_thread(Producer(running));
+
+	std::vector<CaptureOutput*> added;
+	for (int i = 0; i < 20; i++) {
+		added.push_back(new CaptureOutput());
+		LOGGER->addOutput(added.back());
+		first->incrementLvl();
+		first->decrementLvl();
+	}//: for
+	// Make sure that the last output got some messages.
+	while (added.back()->get().empty())
+		boost::this_thread::yield();
+	running.store(false);
+	threads.join_all();
+
+	EXPECT_GT(first->get().size(), 0u);
+	first->setLvl(LFATAL);
+	for (size_t i = 0; i < added.size(); i++)
+		added[i]->setLvl(LFATAL);
+}
+
+
+/*!
+ * Auxiliary function counting its calls.
+ */
+int countedCall(int & counter_) {
+	return ++counter_;
+}
+
+
+/*!
+ * Tests whether stream arguments of disabled messages are not evaluated.
+ */
+TEST(Logger, DisabledLevelSkipsArguments) {
+	CaptureOutput* out = new CaptureOutput(LINFO);
+	LOGGER->addOutput(out);
+	LOGGER->setSeverityLevel(LINFO);
+
+	int calls = 0;
+	LOG(LDEBUG) << countedCall(calls);
+	EXPECT_EQ(calls, 0);
+	EXPECT_FALSE(Logger::isEnabled(LDEBUG));
+
+	LOG(LINFO) << countedCall(calls);
+	EXPECT_EQ(calls, 1);
+
+	// Decrementing the level of a single output must enable the lower level.
+	out->decrementLvl();
+	EXPECT_TRUE(Logger::isEnabled(LNOTICE));
+	LOG(LNOTICE) << countedCall(calls);
+	EXPECT_EQ(calls, 2);
+	EXPECT_EQ(out->get().size(), 2u);
+
+	LOGGER->setSeverityLevel(LFATAL);
+}
+
+
+/*!
+ * Object logging a message from its operator<<.
+ */
+struct NestedLogging { };
+
+std::ostream& operator<<(std::ostream& os_, const NestedLogging&) {
+	LOG(LINFO) << "inner";
+	return os_ << "outer";
+}
+
+
+/*!
+ * Tests whether the reused (thread-local) stream is cleared, handles nested messages and does not leak formatting flags.
+ */
+TEST(Logger, ReusedStream) {
+	CaptureOutput* out = new CaptureOutput();
+	LOGGER->addOutput(out);
+
+	LOG(LINFO) << std::hex << 255 << std::setprecision(2) << 1.2345 << std::setw(4) << std::setfill('*');
+	LOG(LINFO) << 255 << " " << 1.2345 << " " << 7;
+	LOG(LINFO) << "[" << NestedLogging() << "]";
+	LOG(LINFO) << std::string(4000, 'x');
+	LOG(LINFO) << "short";
+
+	std::vector<std::string> msgs = out->get();
+	ASSERT_EQ(msgs.size(), 6u);
+	EXPECT_EQ(msgs[0], "ff1.2");
+	EXPECT_EQ(msgs[1], "255 1.2345 7");
+	EXPECT_EQ(msgs[2], "inner");
+	EXPECT_EQ(msgs[3], "[outer]");
+	EXPECT_EQ(msgs[4], std::string(4000, 'x'));
+	EXPECT_EQ(msgs[5], "short");
+	out->setLvl(LFATAL);
+}
+
+
+/*!
+ * Tests the sampling macros.
+ */
+TEST(Logger, Sampling) {
+	CaptureOutput* out = new CaptureOutput();
+	LOGGER->addOutput(out);
+
+	for (int i = 0; i < 25; i++)
+		LOG_EVERY_N(LINFO, 10) << "every " << i;
+	for (int i = 0; i < 25; i++)
+		LOG_FIRST_N(LINFO, 3) << "first " << i;
+	for (int i = 0; i < 25; i++)
+		LOG_EVERY_T(LINFO, 100000) << "time " << i;
+	for (int i = 0; i < 25; i++)
+		if (i % 2)
+			LOG_RATE_LIMITED(LINFO, 0.001, 4) << "bucket " << i;
+		else
+			LOG(LDEBUG) << "other branch";
+
+	std::vector<std::string> msgs = out->get();
+	ASSERT_EQ(msgs.size(), 3u + 3u + 1u + 4u + 13u);
+	EXPECT_EQ(msgs[0], "every 0");
+	EXPECT_EQ(msgs[1], "every 10 [9 similar messages suppressed]");
+	EXPECT_EQ(msgs[2], "every 20 [9 similar messages suppressed]");
+	EXPECT_EQ(msgs[3], "first 0");
+	EXPECT_EQ(msgs[5], "first 2");
+	EXPECT_EQ(msgs[6], "time 0");
+	out->setLvl(LFATAL);
+}
+
+
+/*!
+ * Logger output storing the call sites of the records.
+ */
+class SiteCaptureOutput : public LoggerOutput {
+public:
+	SiteCaptureOutput() : LoggerOutput(LTRACE) { }
+
+	void print(const std::string &, Severity_t, const std::string &, int) const { }
+
+	void write(const LogRecord & rec_, const LogSite & site_) const {
+		sites.push_back(&site_);
+		EXPECT_EQ(rec_.site, site_.id);
+	}
+
+	mutable std::vector<const LogSite*> sites;
+};
+
+
+/*!
+ * Tests whether every LOG statement registers a single site, which can be looked up by id.
+ */
+TEST(Logger, SiteRegistry) {
+	SiteCaptureOutput* out = new SiteCaptureOutput();
+	LOGGER->addOutput(out);
+
+	EXPECT_STREQ(baseName("/a/b/c.cpp"), "c.cpp");
+	EXPECT_STREQ(baseName("c.cpp"), "c.cpp");
+
+	for (int i = 0; i < 3; i++)
+		LOG(LINFO) << "loop";
+	LOG(LWARNING) << "other";
+	LOGGER->log("legacy.cpp", 7, LINFO, "legacy");
+	LOGGER->log("legacy.cpp", 7, LINFO, "legacy");
+
+	ASSERT_EQ(out->sites.size(), 6u);
+	EXPECT_EQ(out->sites[0], out->sites[2]);
+	EXPECT_NE(out->sites[0], out->sites[3]);
+	EXPECT_EQ(out->sites[4], out->sites[5]);
+	EXPECT_STREQ(out->sites[0]->file, "LoggerTests.cpp");
+	EXPECT_STREQ(out->sites[0]->function, "TestBody");
+	EXPECT_EQ(out->sites[0]->severity, LINFO);
+	EXPECT_EQ(out->sites[3]->line, out->sites[0]->line + 1);
+	EXPECT_EQ(out->sites[4]->file_name, "legacy.cpp");
+	EXPECT_EQ(out->sites[4]->line, 7);
+	for (size_t i = 0; i < out->sites.size(); i++) {
+		EXPECT_LT(out->sites[i]->id, LogSiteRegistry::size());
+		EXPECT_EQ(&LogSiteRegistry::get(out->sites[i]->id), out->sites[i]);
+	}//: for
+	out->setLvl(LFATAL);
+}
+
+
+/*!
+ * Auxiliary function logging a trace message.
+ */
+void traceInHelper(int & counter_) {
+	LOG(LTRACE) << "helper " << countedCall(counter_);
+}
+
+
+/*!
+ * Tests whether dynamic debug rules enable/disable individual sites.
+ */
+TEST(Logger, DynamicDebug) {
+	EXPECT_TRUE(LogSiteRegistry::globMatch("*Episode*", "TrainEpisodeApp.cpp"));
+	EXPECT_TRUE(LogSiteRegistry::globMatch("Key?andler*.cpp", "KeyHandlerRegistry.cpp"));
+	EXPECT_FALSE(LogSiteRegistry::globMatch("*.hpp", "KeyHandlerRegistry.cpp"));
+
+	CaptureOutput* out = new CaptureOutput(LINFO);
+	out->setForcedRecords(true);
+	LOGGER->addOutput(out);
+	CaptureOutput* muted = new CaptureOutput(LINFO);
+	LOGGER->addOutput(muted);
+	LOGGER->setSeverityLevel(LINFO);
+
+	int calls = 0;
+	traceInHelper(calls);
+	EXPECT_EQ(calls, 0);
+
+	// Enable the helper function - its TRACE message must bypass the level of the output accepting forced records only.
+	LogSiteRegistry::setDynamicDebug("traceInHelper");
+	traceInHelper(calls);
+	EXPECT_EQ(calls, 1);
+	ASSERT_EQ(out->get().size(), 1u);
+	EXPECT_EQ(out->get()[0], "helper 1");
+	EXPECT_TRUE(muted->get().empty());
+
+	// Disable the whole file, with exception of the helper.
+	LogSiteRegistry::setDynamicDebug("-LoggerTests.cpp:* +*:traceInHelper");
+	LOG(LERROR) << countedCall(calls);
+	EXPECT_EQ(calls, 1);
+	traceInHelper(calls);
+	EXPECT_EQ(calls, 2);
+
+	LogSiteRegistry::setDynamicDebug("");
+	traceInHelper(calls);
+	LOG(LERROR) << countedCall(calls);
+	EXPECT_EQ(calls, 3);
+	EXPECT_EQ(out->get().size(), 3u);
+	EXPECT_EQ(muted->get().size(), 1u);
+	LOGGER->setSeverityLevel(LFATAL);
+}
+
+
+/*!
+ * Tests whether the messages of sites enabled by dynamic debug rules reach the console output with its default settings.
+ */
+TEST(Logger, DynamicDebugReachesConsole) {
+	ConsoleOutput* console = new ConsoleOutput();
+	LOGGER->addOutput(console);
+
+	// Capture the console.
+	std::ostringstream captured;
+	std::streambuf * cout_buf = std::cout.rdbuf(captured.rdbuf());
+	int calls = 0;
+	traceInHelper(calls);
+	LogSiteRegistry::setDynamicDebug("traceInHelper");
+	traceInHelper(calls);
+	LogSiteRegistry::setDynamicDebug("");
+	traceInHelper(calls);
+	LOGGER->flush();
+	std::cout.rdbuf(cout_buf);
+
+	EXPECT_EQ(calls, 1);
+	EXPECT_NE(captured.str().find("helper 1"), std::string::npos);
+	EXPECT_EQ(captured.str().find("helper 0"), std::string::npos);
+	console->setLvl(LFATAL);
+	console->setForcedRecords(false);
+}
+
+
+namespace categorized {
+MIC_LOG_CATEGORY("test.categories.leaf")
+
+/*!
+ * Auxiliary function logging messages of all severities in the "test.categories.leaf" category.
+ */
+void logAll(int & counter_) {
+	LOG(LDEBUG) << "debug " << countedCall(counter_);
+	LOG(LINFO) << "info " << countedCall(counter_);
+	LOG(LWARNING) << "warning " << countedCall(counter_);
+}
+
+} /* namespace categorized */
+
+
+/*!
+ * Tests whether levels of categories are inherited and replace the levels of outputs.
+ */
+TEST(Logger, Categories) {
+	LogCategory & leaf = LogCategory::get("test.categories.leaf");
+	ASSERT_TRUE(leaf.getParent() != NULL);
+	EXPECT_EQ(leaf.getParent()->getName(), "test.categories");
+	EXPECT_EQ(&LogCategory::get("test.categories"), leaf.getParent());
+
+	CaptureOutput* out = new CaptureOutput(LINFO);
+	out->setForcedRecords(true);
+	LOGGER->addOutput(out);
+	CaptureOutput* muted = new CaptureOutput(LINFO);
+	LOGGER->addOutput(muted);
+	LOGGER->setSeverityLevel(LINFO);
+
+	// No category levels - the output level applies.
+	int calls = 0;
+	categorized::logAll(calls);
+	EXPECT_EQ(calls, 2);
+
+	// Level inherited from the ancestor - DEBUG bypasses the INFO output.
+	EXPECT_TRUE(LogCategory::setLevels("test=DEBUG"));
+	categorized::logAll(calls);
+	EXPECT_EQ(calls, 5);
+
+	// Own level of the leaf overrides the inherited one.
+	EXPECT_FALSE(LogCategory::setLevels("test.categories.leaf=WARNING test.categories=NOLEVEL"));
+	categorized::logAll(calls);
+	EXPECT_EQ(calls, 6);
+
+	EXPECT_TRUE(LogCategory::setLevels("test=INHERIT test.categories.leaf="));
+	EXPECT_EQ(leaf.getThreshold(), LogCategory::no_level);
+	categorized::logAll(calls);
+	EXPECT_EQ(calls, 8);
+	EXPECT_EQ(out->get().size(), 8u);
+	// Output not accepting forced records applies its own level (no DEBUG messages).
+	EXPECT_EQ(muted->get().size(), 7u);
+	LOGGER->setSeverityLevel(LFATAL);
+}
+
+
+/*!
+ * Tests whether a category level below the level of the console output makes the category more verbose on the console.
+ */
+TEST(Logger, CategoryLevelReachesConsole) {
+	ConsoleOutput* console = new ConsoleOutput();
+	LOGGER->addOutput(console);
+
+	std::ostringstream captured;
+	std::streambuf * cout_buf = std::cout.rdbuf(captured.rdbuf());
+	int calls = 0;
+	EXPECT_TRUE(LogCategory::setLevels("test.categories=DEBUG"));
+	categorized::logAll(calls);
+	EXPECT_TRUE(LogCategory::setLevels("test.categories=INHERIT"));
+	LOGGER->flush();
+	std::cout.rdbuf(cout_buf);
+
+	EXPECT_EQ(calls, 3);
+	EXPECT_NE(captured.str().find("debug 1"), std::string::npos);
+	console->setLvl(LFATAL);
+	console->setForcedRecords(false);
+}
+
+
+/*!
+ * Logger output storing the timestamps and thread ids of records.
+ */
+class StampOutput : public CaptureOutput {
+public:
+	void write(const LogRecord & rec_, const LogSite & site_) const {
+		boost::mutex::scoped_lock lock(mutex);
+		stamps.push_back(std::make_pair(rec_.timestamp, rec_.thread));
+	}
+
+	mutable boost::mutex mutex;
+	mutable std::vector<std::pair<int64_t, uint32_t> > stamps;
+};
+
+
+/*!
+ * Tests whether records carry monotonic timestamps and compact thread ids, and the format of the prefix.
+ */
+TEST(Logger, TimestampsAndThreads) {
+	StampOutput* out = new StampOutput();
+	LOGGER->addOutput(out);
+
+	int64_t before = monotonicNs();
+	LOG(LINFO) << "main";
+	BLOG(LINFO) << "main " << 1;
+	boost::thread t([]() { LOG(LINFO) << "thread"; });
+	t.join();
+	int64_t after = monotonicNs();
+
+	ASSERT_EQ(out->stamps.size(), 3u);
+	EXPECT_LE(before, out->stamps[0].first);
+	EXPECT_LE(out->stamps[0].first, out->stamps[1].first);
+	EXPECT_LE(out->stamps[2].first, after);
+	EXPECT_EQ(out->stamps[0].second, threadId());
+	EXPECT_EQ(out->stamps[1].second, threadId());
+	EXPECT_NE(out->stamps[2].second, threadId());
+	EXPECT_GT(out->stamps[2].second, 0u);
+
+	// "YYYY-MM-DD HH:MM:SS.mmm" - the same second is formatted from the cache.
+	char buf[timestamp_length];
+	EXPECT_EQ(formatTimestamp(before, buf), 23u);
+	EXPECT_EQ(buf[4], '-');
+	EXPECT_EQ(buf[10], ' ');
+	EXPECT_EQ(buf[19], '.');
+	std::string first(buf, 19);
+	if (std::atoi(buf + 20) < 990) {
+		formatTimestamp(before + 1000000, buf);
+		EXPECT_EQ(std::string(buf, 19), first);
+	}//: if
+	out->setLvl(LFATAL);
+}
+
+
+/*!
+ * Tests whether messages captured in binary form are formatted exactly as the stream-based ones.
+ */
+TEST(Logger, BinaryArgumentsFormatting) {
+	CaptureOutput* out = new CaptureOutput();
+	LOGGER->addOutput(out);
+
+	short s = -3;
+	unsigned long ul = 123456789ul;
+	float f = 0.1f;
+	const char * cstr = "cstr";
+	std::string str("string");
+	LOG(LINFO) << "val " << s << ' ' << ul << ' ' << 3.14159265 << ' ' << f << ' ' << true << ' ' << cstr << ' ' << str << ' ' << 1e20;
+	BLOG(LINFO) << "val " << s << ' ' << ul << ' ' << 3.14159265 << ' ' << f << ' ' << true << ' ' << cstr << ' ' << str << ' ' << 1e20;
+
+	std::vector<std::string> msgs = out->get();
+	ASSERT_EQ(msgs.size(), 2u);
+	EXPECT_EQ(msgs[0], msgs[1]);
+	out->setLvl(LFATAL);
+}
+
+
+/*!
+ * Reads the whole file.
+ */
+std::string readFile(const std::string & name_) {
+	std::ifstream in(name_.c_str());
+	return std::string((std::istreambuf_iterator<char>(in)), std::istreambuf_iterator<char>());
+}
+
+
+/*!
+ * Temporary directory for the files written by a test - removed together with all its files at the end of the test.
+ */
+class TempDir {
+public:
+	TempDir() {
+		const char * tmp = std::getenv("TMPDIR");
+		std::string pattern = std::string((tmp && *tmp) ? tmp : "/tmp") + "/unit_tests_logger-XXXXXX";
+		std::vector<char> buf(pattern.begin(), pattern.end());
+		buf.push_back('\0');
+		if (mkdtemp(&buf[0]) == NULL)
+			throw std::runtime_error("Cannot create temporary directory " + pattern);
+		dir = &buf[0];
+	}
+
+	~TempDir() {
+		DIR * d = opendir(dir.c_str());
+		if (d) {
+			struct dirent * entry;
+			while ((entry = readdir(d)) != NULL) {
+				std::string name = entry->d_name;
+				if ((name != ".") && (name != ".."))
+					::unlink(path(name).c_str());
+			}//: while
+			closedir(d);
+		}//: if
+		::rmdir(dir.c_str());
+	}
+
+	/*!
+	 * Returns the path of the file in the directory.
+	 */
+	std::string path(const std::string & name_) const {
+		return dir + "/" + name_;
+	}
+
+private:
+	/// Path of the directory.
+	std::string dir;
+};
+
+
+/*!
+ * Tests whether file output buffers the messages, splits them by severity and rotates the files.
+ */
+TEST(FileOutput, SplitAndRotate) {
+	TempDir tmp;
+	{
+		FileOutput out(tmp.path("unit_tests_logger.log"), LTRACE, true);
+		out.setRotation(100, 0, 2);
+
+		out.print("first", LINFO, "file.cpp", 1);
+		out.endOfBatch();
+		// Nothing written yet - the message stays in the buffer.
+		EXPECT_EQ(readFile(tmp.path("unit_tests_logger.INFO.log")), "");
+		out.print("error", LERROR, "file.cpp", 2);
+		out.flush();
+		EXPECT_EQ(readFile(tmp.path("unit_tests_logger.INFO.log")), "INFO: first\n");
+		EXPECT_EQ(readFile(tmp.path("unit_tests_logger.ERROR.log")), "ERROR: error\n");
+
+		// Exceed the size limit.
+		for (int i = 0; i < 20; i++)
+			out.print("0123456789", LINFO, "file.cpp", 3);
+	}
+	EXPECT_FALSE(readFile(tmp.path("unit_tests_logger.INFO.log.1")).empty());
+	EXPECT_LT(readFile(tmp.path("unit_tests_logger.INFO.log")).size(), 100u);
+}
+
+
+/*!
+ * Tests whether the timer thread writes the buffered data older than the flush interval, even when no more messages arrive.
+ */
+TEST(FileOutput, FlushIntervalWithoutRecords) {
+	TempDir tmp;
+	FileOutput out(tmp.path("unit_tests_logger.log"), LTRACE);
+	out.setFlushInterval(20);
+	out.print("idle", LINFO, "file.cpp", 1);
+	// Neither flush() nor endOfBatch() - the timer thread must write the buffer by itself.
+	std::string contents;
+	for (int i = 0; (i < 100) && contents.empty(); i++) {
+		boost::this_thread::sleep(boost::posix_time::milliseconds(10));
+		contents = readFile(tmp.path("unit_tests_logger.log"));
+	}//: for
+	EXPECT_EQ(contents, "INFO: idle\n");
+}
+
+
+/*!
+ * Tests whether a file that cannot be reopened during rotation does not break the logging.
+ */
+TEST(FileOutput, RotationFailureDoesNotThrow) {
+	TempDir tmp;
+	const std::string dir = tmp.path("sub");
+	ASSERT_EQ(::mkdir(dir.c_str(), 0700), 0);
+	FileOutput out(dir + "/unit_tests_logger.log", LTRACE);
+	out.setRotation(50, 0, 0);
+	out.print("first", LINFO, "file.cpp", 1);
+	out.flush();
+
+	// Remove the directory - the file cannot be reopened.
+	ASSERT_EQ(::unlink((dir + "/unit_tests_logger.log").c_str()), 0);
+	ASSERT_EQ(::rmdir(dir.c_str()), 0);
+	for (int i = 0; i < 10; i++)
+		EXPECT_NO_THROW(out.print("0123456789", LINFO, "file.cpp", 2));
+	EXPECT_NO_THROW(out.flush());
+}
+
+
+#ifdef MIC_HAVE_ZLIB
+/*!
+ * Reads and decompresses the whole gzip file - or its readable part.
+ */
+std::string readGzip(const std::string & name_) {
+	std::string data;
+	gzFile f = gzopen(name_.c_str(), "rb");
+	if (!f)
+		return data;
+	char buf[4096];
+	int n;
+	while ((n = gzread(f, buf, sizeof(buf))) > 0)
+		data.append(buf, n);
+	gzclose(f);
+	return data;
+}
+
+
+/*!
+ * Tests whether the compressed output writes independent frames (readable after truncation) and rotates by compressed size.
+ */
+TEST(CompressedFileOutput, FramesAndRotation) {
+	TempDir tmp;
+	const std::string name = tmp.path("unit_tests_logger.log.gz");
+	std::string expected;
+	off_t first_frame;
+	{
+		CompressedFileOutput out(name, LTRACE, 64);
+		out.print("first", LINFO, "file.cpp", 1);
+		out.flush();
+		EXPECT_EQ(readGzip(name), "INFO: first\n");
+		struct stat st;
+		ASSERT_EQ(::stat(name.c_str(), &st), 0);
+		first_frame = st.st_size;
+
+		expected = "INFO: first\n";
+		for (int i = 0; i < 20; i++) {
+			out.print("line " + boost::lexical_cast<std::string>(i), LINFO, "file.cpp", 2);
+			expected += "INFO: line " + boost::lexical_cast<std::string>(i) + "\n";
+		}//: for
+	}
+	EXPECT_EQ(readGzip(name), expected);
+
+	// Cut the last frame - the complete ones stay readable.
+	struct stat st;
+	ASSERT_EQ(::stat(name.c_str(), &st), 0);
+	ASSERT_GT(st.st_size, first_frame);
+	ASSERT_EQ(::truncate(name.c_str(), st.st_size - 4), 0);
+	std::string truncated = readGzip(name);
+	EXPECT_EQ(truncated.compare(0, 12, "INFO: first\n"), 0);
+
+	// Rotation by the compressed size.
+	std::remove(name.c_str());
+	{
+		CompressedFileOutput out(name, LTRACE, 64);
+		out.setRotation(200, 1);
+		for (int i = 0; i < 100; i++)
+			out.print("message " + boost::lexical_cast<std::string>(i), LINFO, "file.cpp", 3);
+	}
+	EXPECT_FALSE(readGzip(tmp.path("unit_tests_logger.log.1.gz")).empty());
+	ASSERT_EQ(::stat(name.c_str(), &st), 0);
+	EXPECT_LT(st.st_size, 400);
+}
+
+
+/*!
+ * Tests whether the compression thread writes the block older than the flush interval, even when no more records arrive.
+ */
+TEST(CompressedFileOutput, FlushIntervalWithoutRecords) {
+	TempDir tmp;
+	const std::string name = tmp.path("unit_tests_logger.log.gz");
+	CompressedFileOutput out(name, LTRACE);
+	out.setFlushInterval(20);
+	out.print("idle", LINFO, "file.cpp", 1);
+	// Neither flush() nor endOfBatch() - the thread must submit the block by itself.
+	struct stat st;
+	for (int i = 0; i < 100; i++) {
+		boost::this_thread::sleep(boost::posix_time::milliseconds(10));
+		if ((::stat(name.c_str(), &st) == 0) && (st.st_size > 0))
+			break;
+	}//: for
+	EXPECT_EQ(readGzip(name), "INFO: idle\n");
+}
+#endif
+
+
+int main(int argc, char **argv) {
+    testing::InitGoogleTest(&argc, argv);
+    return RUN_ALL_TESTS();
+}
+
+
+/*!
+ * Tests whether the flight recorder keeps the last records of all severities and whether they can be dumped from the file.
+ */
+TEST(FlightRecorderOutput, KeepsLastRecords) {
+	TempDir tmp;
+	FlightRecorderOutput* rec = new FlightRecorderOutput(tmp.path("unit_tests_logger.ring"), 4, 128);
+	LOGGER->addOutput(rec);
+	EXPECT_EQ(FlightRecorderOutput::active(), rec);
+
+	for (int i = 0; i < 6; i++)
+		LOG(LTRACE) << "trace " << i;
+	BLOG(LDEBUG) << "binary " << 6;
+	LOG(LINFO) << std::string(200, 'x');
+
+	std::ostringstream os;
+	rec->dump(os);
+	std::string dump = os.str();
+	EXPECT_EQ(dump.find("trace 3"), std::string::npos);
+	size_t p4 = dump.find("TRACE in LoggerTests.cpp");
+	size_t p5 = dump.find("trace 5");
+	size_t p6 = dump.find("binary 6");
+	ASSERT_NE(p4, std::string::npos);
+	ASSERT_NE(p5, std::string::npos);
+	ASSERT_NE(p6, std::string::npos);
+	EXPECT_LT(p4, p5);
+	EXPECT_LT(p5, p6);
+	EXPECT_NE(dump.find("x [truncated]"), std::string::npos);
+
+	// The ring file contains the same records.
+	std::ostringstream file_os;
+	EXPECT_TRUE(FlightRecorderOutput::dumpFile(tmp.path("unit_tests_logger.ring"), file_os));
+	EXPECT_EQ(file_os.str(), dump);
+	std::ofstream(tmp.path("unit_tests_logger.INFO.log").c_str()) << "INFO: not a ring\n";
+	std::ostringstream bad_os;
+	EXPECT_FALSE(FlightRecorderOutput::dumpFile(tmp.path("unit_tests_logger.INFO.log"), bad_os));
+	rec->setLvl(LFATAL);
+}
+
+
+/*!
+ * Tests whether records published into the shared memory can be read by a viewer, which detects the records it missed.
+ */
+TEST(SharedMemoryOutput, ViewerReadsRecords) {
+	// Object left by a crashed run.
+	shm_unlink("/mic_unit_tests_logger");
+	SharedMemoryOutput* shm = new SharedMemoryOutput("/mic_unit_tests_logger", 4, 128);
+	LOGGER->addOutput(shm);
+
+	// Existing object is not taken over.
+	EXPECT_THROW(SharedMemoryOutput("/mic_unit_tests_logger", 4, 128), std::runtime_error);
+
+	// Viewer - separate read-only mapping of the object.
+	int fd = shm_open("/mic_unit_tests_logger", O_RDONLY, 0);
+	ASSERT_GE(fd, 0);
+	struct stat st;
+	ASSERT_EQ(fstat(fd, &st), 0);
+	EXPECT_EQ(st.st_mode & 0777, 0600u);
+	void * ptr = mmap(NULL, st.st_size, PROT_READ, MAP_SHARED, fd, 0);
+	close(fd);
+	ASSERT_NE(ptr, MAP_FAILED);
+	LogRing ring((const char*)ptr, st.st_size);
+	ASSERT_TRUE(ring.valid());
+	EXPECT_EQ(ring.getSlots(), 4u);
+
+	RingEntry entry;
+	EXPECT_EQ(ring.read(0, entry), RingNotYet);
+	LOG(LINFO) << "first " << 1;
+	ASSERT_EQ(ring.read(0, entry), RingOk);
+	EXPECT_EQ(entry.text(), "first 1");
+	EXPECT_EQ(entry.severity, LINFO);
+	EXPECT_EQ(entry.file, "LoggerTests.cpp");
+	EXPECT_EQ(entry.thread, threadId());
+
+	// Records of filtered levels are not published, the slow viewer misses the overwritten ones.
+	LOG(LDEBUG) << "skipped";
+	for (int i = 0; i < 5; i++)
+		BLOG(LWARNING) << "next " << i;
+	EXPECT_EQ(ring.next(), 6u);
+	EXPECT_EQ(ring.read(1, entry), RingOverwritten);
+	ASSERT_EQ(ring.read(5, entry), RingOk);
+	EXPECT_EQ(entry.text(), "next 4");
+	EXPECT_EQ(ring.read(6, entry), RingNotYet);
+
+	munmap(ptr, st.st_size);
+	shm->setLvl(LFATAL);
+	shm_unlink("/mic_unit_tests_logger");
+
+	// Default name is per-process, the object is unlinked by the destructor.
+	{
+		SharedMemoryOutput own;
+		EXPECT_EQ(own.getName(), SharedMemoryOutput::processName(getpid()));
+	}
+	EXPECT_LT(shm_open(SharedMemoryOutput::processName(getpid()).c_str(), O_RDONLY, 0), 0);
+}
+
+
+/*!
+ * Tests whether the shared memory object of an exiting process is unlinked, although the output was never destroyed.
+ */
+TEST(SharedMemoryOutput, UnlinkedAtExit) {
+	pid_t child = fork();
+	ASSERT_GE(child, 0);
+	if (child == 0) {
+		new SharedMemoryOutput();
+		std::exit(0);
+	}//: if
+	int status = 0;
+	ASSERT_EQ(waitpid(child, &status, 0), child);
+	ASSERT_TRUE(WIFEXITED(status));
+	int fd = shm_open(SharedMemoryOutput::processName(child).c_str(), O_RDONLY, 0);
+	EXPECT_LT(fd, 0);
+	if (fd >= 0) {
+		close(fd);
+		shm_unlink(SharedMemoryOutput::processName(child).c_str());
+	}//: if
+}
+
+
+/*!
+ * Tests the number formatters.
+ */
+TEST(NumberFormat, FormatsNumbers) {
+	char buf[number_length];
+	EXPECT_EQ(std::string(buf, formatUnsigned(0, buf)), "0");
+	EXPECT_EQ(std::string(buf, formatUnsigned(18446744073709551615ull, buf)), "18446744073709551615");
+	EXPECT_EQ(std::string(buf, formatSigned(-1234567, buf)), "-1234567");
+	EXPECT_EQ(std::string(buf, formatSigned(std::numeric_limits<int64_t>::min(), buf)), "-9223372036854775808");
+	EXPECT_EQ(std::string(buf, formatDouble(0.1, buf)), "0.1");
+	EXPECT_EQ(std::string(buf, formatDouble(-42.0, buf)), "-42");
+	EXPECT_EQ(std::string(buf, formatDouble(1e300, buf)), "1e+300");
+	EXPECT_EQ(std::string(buf, formatDouble(-std::numeric_limits<double>::infinity(), buf)), "-inf");
+	double third = 1.0 / 3;
+	EXPECT_EQ(std::strtod(std::string(buf, formatDouble(third, buf)).c_str(), NULL), third);
+}
+
+
+/*!
+ * Tests whether the structured records are printed as text by the text outputs and as typed fields by the JSON-lines output.
+ */
+TEST(JsonLinesOutput, StructuredRecords) {
+	TempDir tmp;
+	CaptureOutput* text = new CaptureOutput(LINFO);
+	JsonLinesOutput* json = new JsonLinesOutput(tmp.path("unit_tests_logger.jsonl"));
+	LOGGER->addOutput(text);
+	LOGGER->addOutput(json);
+
+	int iter = 5;
+	double loss = 0.25;
+	LOG_KV(LINFO, "step_done", "iter", iter, "loss", loss, "phase", "train", "ok", true, std::string("nan"), std::nan(""));
+	LOG_KV(LWARNING, "started");
+	LOG(LINFO) << "quote \" and\nnewline";
+	LOG_KV(LINFO, "clash", "level", 7, "msg", "user");
+	json->flush();
+
+	ASSERT_EQ(text->get().size(), 4u);
+	EXPECT_EQ(text->get()[0], "step_done iter=5 loss=0.25 phase=train ok=1 nan=nan");
+	EXPECT_EQ(text->get()[1], "started");
+
+	std::istringstream lines(readFile(tmp.path("unit_tests_logger.jsonl")));
+	std::string line;
+	ASSERT_TRUE(std::getline(lines, line));
+	EXPECT_EQ(line.find("{\"time\":\""), 0u);
+	EXPECT_NE(line.find("\"level\":\"INFO\",\"file\":\"LoggerTests.cpp\""), std::string::npos);
+	EXPECT_NE(line.find(",\"event\":\"step_done\",\"fields\":{\"iter\":5,\"loss\":0.25,\"phase\":\"train\",\"ok\":true,\"nan\":null}}"), std::string::npos);
+	ASSERT_TRUE(std::getline(lines, line));
+	EXPECT_NE(line.find("\"level\":\"WARNING\""), std::string::npos);
+	EXPECT_NE(line.find(",\"event\":\"started\"}"), std::string::npos);
+	ASSERT_TRUE(std::getline(lines, line));
+	EXPECT_NE(line.find(",\"msg\":\"quote \\\" and\\nnewline\"}"), std::string::npos);
+	// User keys colliding with the keys of the record do not duplicate them.
+	ASSERT_TRUE(std::getline(lines, line));
+	EXPECT_NE(line.find("\"level\":\"INFO\","), std::string::npos);
+	EXPECT_NE(line.find(",\"event\":\"clash\",\"fields\":{\"level\":7,\"msg\":\"user\"}}"), std::string::npos);
+	EXPECT_EQ(line.find("\"msg\""), line.rfind("\"msg\""));
+	EXPECT_FALSE(std::getline(lines, line));
+
+	// Key without value is closed with null.
+	std::string out;
+	std::string args;
+	binary::appendString(args, "ev", 2, binary::EventArg);
+	binary::appendString(args, "key", 3, binary::KeyArg);
+	EXPECT_FALSE(JsonLinesOutput::appendFields(out, args.data(), args.size()));
+	EXPECT_EQ(out, ",\"event\":\"ev\",\"fields\":{\"key\":null}");
+
+	text->setLvl(LFATAL);
+	json->setLvl(LFATAL);
+}
+
+
+// Format strings are validated at compile time.
+static_assert(format::placeholders("iter {} loss {:.4f} {:8d} {{literal}}") == 3, "Invalid number of placeholders");
+static_assert(format::placeholders("no placeholders") == 0, "Invalid number of placeholders");
+static_assert(format::placeholders("unmatched {") == -1, "Unmatched brace accepted");
+static_assert(format::placeholders("unmatched } brace") == -1, "Unmatched brace accepted");
+static_assert(format::placeholders("invalid {:q}") == -1, "Invalid type accepted");
+
+
+/*!
+ * Tests the formatting of LOGF messages.
+ */
+TEST(Logger, FormattedMessages) {
+	CaptureOutput* out = new CaptureOutput(LINFO);
+	LOGGER->addOutput(out);
+
+	int calls = 0;
+	LOGF(LINFO, "iter {} loss {:.4f} {}", 42, 0.123456, "done");
+	LOGF(LINFO, "{{{}}} [{:5}] [{:<5s}] [{:.2s}] {:x} {} {}", -7, 12, "ab", "abcdef", 255u, true, 'c');
+	LOGF(LINFO, "{} {} {:.2e} {:.3g} {:f} {}", 0.1, 1e21, 12345.678, 2.0 / 3, -0.5, std::string("str"));
+	LOGF(LINFO, "no arguments");
+	LOGF(LDEBUG, "disabled {}", countedCall(calls));
+	EXPECT_EQ(calls, 0);
+
+	std::vector<std::string> msgs = out->get();
+	ASSERT_EQ(msgs.size(), 4u);
+	EXPECT_EQ(msgs[0], "iter 42 loss 0.1235 done");
+	EXPECT_EQ(msgs[1], "{-7} [   12] [ab   ] [ab] ff true c");
+	EXPECT_EQ(msgs[2], "0.1 1e+21 1.23e+04 0.667 -0.500000 str");
+	EXPECT_EQ(msgs[3], "no arguments");
+	out->setLvl(LFATAL);
+}
+
+
+/*!
+ * Tests the CHECK macros - failures of a site are counted and logged with decreasing frequency, operands are printed.
+ */
+TEST(Logger, Checks) {
+	CaptureOutput* out = new CaptureOutput(LWARNING);
+	LOGGER->addOutput(out);
+
+	int evaluated = 0;
+	for (int i = 0; i < 10; i++)
+		CHECK(++evaluated < 0) << " at " << i;
+	EXPECT_EQ(evaluated, 10);
+	CHECK(evaluated == 10) << countedCall(evaluated);
+	int rows = 4;
+	CHECK_EQ(rows, 3);
+	CHECK_LT(rows++, 5);
+	EXPECT_EQ(rows, 5);
+	if (rows > 0)
+		CHECK_GE(rows, 6);
+	else
+		FAIL();
+
+	int debug_calls = 0;
+	DCHECK(++debug_calls < 0);
+	DCHECK_EQ(++debug_calls, 0);
+	EXPECT_EQ(debug_calls, MIC_DCHECK_IS_ON ? 2 : 0);
+
+	std::vector<std::string> msgs = out->get();
+	ASSERT_EQ(msgs.size(), (MIC_DCHECK_IS_ON ? 8u : 6u));
+	EXPECT_EQ(msgs[0], "Check failed: ++evaluated < 0 at 0");
+	EXPECT_EQ(msgs[1], "Check failed: ++evaluated < 0 [failed 2 times] at 1");
+	EXPECT_EQ(msgs[2], "Check failed: ++evaluated < 0 [failed 4 times] at 3");
+	EXPECT_EQ(msgs[3], "Check failed: ++evaluated < 0 [failed 8 times] at 7");
+	EXPECT_EQ(msgs[4], "Check failed: rows == 3 (4 vs. 3)");
+	EXPECT_EQ(msgs[5], "Check failed: rows >= 6 (5 vs. 6)");
+	out->setLvl(LFATAL);
+}
+
+
+// CHECK is a single expression - it must not trigger -Wdangling-else in unbraced if-else and can be used e.g. in comma expressions.
+#if defined(__GNUC__)
+#pragma GCC diagnostic push
+#pragma GCC diagnostic error "-Wdangling-else"
+#endif
+TEST(Logger, CheckIsExpression) {
+	CaptureOutput* out = new CaptureOutput(LWARNING);
+	LOGGER->addOutput(out);
+
+	int branch = 0;
+	for (int v = -1; v <= 1; v += 2)
+		if (v != 0)
+			CHECK(v > 0) << " v = " << v;
+		else
+			branch++;
+	EXPECT_EQ(branch, 0);
+
+	int after = 0;
+	bool ok = true;
+	CHECK(ok) << countedCall(after), after++;
+	EXPECT_EQ(after, 1);
+	ok ? (void)0 : CHECK(ok);
+
+	std::vector<std::string> msgs = out->get();
+	ASSERT_EQ(msgs.size(), 1u);
+	EXPECT_EQ(msgs[0], "Check failed: v > 0 v = -1");
+	out->setLvl(LFATAL);
+}
+#if defined(__GNUC__)
+#pragma GCC diagnostic pop
+#endif
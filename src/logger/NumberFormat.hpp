@@ -0,0 +1,177 @@
+/*!
+ * Copyright (C) tkornuta, IBM Corporation 2015-2019
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+/*!
+ * \file NumberFormat.hpp
+ * \brief Contains functions formatting numbers into character buffers - without streams, locales or allocations.
+ * \author tkornuta
+ * \date Oct 17, 2026
+ */
+
+#ifndef SRC_LOGGER_NUMBERFORMAT_HPP_
+#define SRC_LOGGER_NUMBERFORMAT_HPP_
+
+#include <boost/cstdint.hpp>
+
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+
+#include <locale.h>
+
+namespace mic {
+namespace logger {
+
+/// Size of the buffer sufficient for any number formatted by the functions below.
+const size_t number_length = 32;
+
+/*!
+ * Returns the C locale (created once) - used for formatting and parsing of floating point numbers regardless of the locale of the process.
+ */
+inline locale_t cLocale() {
+	static locale_t loc = newlocale(LC_ALL_MASK, "C", (locale_t)0);
+	return loc;
+}
+
+/*!
+ * \brief Switches the current thread to the C locale for its lifetime (so printf uses the decimal point), restores the previous locale when destroyed.
+ * \author tkornuta
+ */
+class CLocaleScope {
+public:
+	CLocaleScope() : previous(uselocale(cLocale())) { }
+
+	~CLocaleScope() {
+		uselocale(previous);
+	}
+
+private:
+	/// Locale of the thread before the switch.
+	locale_t previous;
+
+	CLocaleScope(const CLocaleScope &);
+	CLocaleScope& operator =(const CLocaleScope &);
+};
+
+/*!
+ * Formats the unsigned integer - two digits at a time.
+ * @param val_ Value.
+ * @param buf_ Output buffer (of at least number_length characters).
+ * @return Number of written characters.
+ */
+inline size_t formatUnsigned(uint64_t val_, char * buf_) {
+	static const char digits[] =
+		"00010203040506070809101112131415161718192021222324252627282930313233343536373839404142434445464748495051525354555657585960616263646566676869707172737475767778798081828384858687888990919293949596979899";
+	char tmp[20];
+	char * p = tmp + sizeof(tmp);
+	while (val_ >= 100) {
+		unsigned i = (unsigned)(val_ % 100) * 2;
+		val_ /= 100;
+		*--p = digits[i + 1];
+		*--p = digits[i];
+	}//: while
+	if (val_ >= 10) {
+		unsigned i = (unsigned)val_ * 2;
+		*--p = digits[i + 1];
+		*--p = digits[i];
+	} else
+		*--p = (char)('0' + val_);
+	size_t len = tmp + sizeof(tmp) - p;
+	std::memcpy(buf_, p, len);
+	return len;
+}
+
+/*!
+ * Formats the signed integer.
+ * @param val_ Value.
+ * @param buf_ Output buffer (of at least number_length characters).
+ * @return Number of written characters.
+ */
+inline size_t formatSigned(int64_t val_, char * buf_) {
+	if (val_ >= 0)
+		return formatUnsigned((uint64_t)val_, buf_);
+	buf_[0] = '-';
+	return 1 + formatUnsigned(~(uint64_t)val_ + 1, buf_ + 1);
+}
+
+/*!
+ * Formats the floating point number with the shortest of 15 or 17 significant digits that reads back as the same value,
+ * integral values (e.g. iteration counts stored as doubles) are formatted as integers. Not finite values are formatted as nan/inf/-inf.
+ * Always uses the C locale conventions (decimal point), regardless of LC_NUMERIC of the process - so the value can be parsed back (see cLocale()).
+ * @param val_ Value.
+ * @param buf_ Output buffer (of at least number_length characters).
+ * @return Number of written characters.
+ */
+inline size_t formatDouble(double val_, char * buf_) {
+	if (std::isnan(val_)) {
+		std::memcpy(buf_, "nan", 3);
+		return 3;
+	}//: if
+	if (std::isinf(val_)) {
+		std::memcpy(buf_, (val_ < 0) ? "-inf" : "inf", (val_ < 0) ? 4 : 3);
+		return (val_ < 0) ? 4 : 3;
+	}//: if
+	// Fast path - integral values.
+	if ((val_ > -1e15) && (val_ < 1e15) && (val_ == (double)(int64_t)val_))
+		return formatSigned((int64_t)val_, buf_);
+	CLocaleScope c_locale;
+	int len = std::snprintf(buf_, number_length, "%.15g", val_);
+	if (strtod_l(buf_, NULL, cLocale()) != val_)
+		len = std::snprintf(buf_, number_length, "%.17g", val_);
+	return (size_t)len;
+}
+
+/*!
+ * Formats the floating point number with given number of digits after the decimal point (as printf "%.*f").
+ * Values that can be scaled to an exactly representable integer (|value| * 10^precision < 2^53, precision up to 9) are formatted without printf,
+ * the scaled value is rounded half to even - so ties can differ from printf, which rounds the exact binary value.
+ * @param val_ Value.
+ * @param precision_ Number of digits after the decimal point.
+ * @param buf_ Output buffer (of at least number_length characters).
+ * @return Number of written characters.
+ */
+inline size_t formatFixed(double val_, int precision_, char * buf_) {
+	static const double scales[] = { 1e0, 1e1, 1e2, 1e3, 1e4, 1e5, 1e6, 1e7, 1e8, 1e9 };
+	if ((precision_ < 0) || (precision_ > 9) || !(std::fabs(val_) * scales[precision_] < 9007199254740992.0)) {
+		CLocaleScope c_locale;
+		int len = std::snprintf(buf_, number_length, "%.*f", (precision_ < 0) ? 6 : precision_, val_);
+		// Very large values do not fit into the buffer - use the exponent notation.
+		if (len >= (int)number_length)
+			len = std::snprintf(buf_, number_length, "%.17g", val_);
+		return (size_t)len;
+	}//: if
+	uint64_t scale = (uint64_t)scales[precision_];
+	uint64_t scaled = (uint64_t)std::nearbyint(std::fabs(val_) * scales[precision_]);
+	size_t len = 0;
+	if (std::signbit(val_) && (scaled != 0))
+		buf_[len++] = '-';
+	len += formatUnsigned(scaled / scale, buf_ + len);
+	if (precision_ > 0) {
+		buf_[len++] = '.';
+		uint64_t frac = scaled % scale;
+		for (int i = precision_ - 1; i >= 0; i--) {
+			buf_[len + i] = (char)('0' + frac % 10);
+			frac /= 10;
+		}//: for
+		len += precision_;
+	}//: if
+	return len;
+}
+
+} /* namespace logger */
+} /* namespace mic */
+
+#endif /* SRC_LOGGER_NUMBERFORMAT_HPP_ */
@@ -0,0 +1,185 @@
+/*!
+ * Copyright (C) tkornuta, IBM Corporation 2015-2019
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+/*!
+ * \file RingBuffer.hpp
+ * \brief Contains definition of a bounded, lock-free multi-producer ring buffer used by the asynchronous logger.
+ * \author tkornuta
+ * \date Oct 17, 2026
+ */
+
+#ifndef SRC_LOGGER_RINGBUFFER_HPP_
+#define SRC_LOGGER_RINGBUFFER_HPP_
+
+#include <boost/atomic.hpp>
+
+#include <cstddef>
+#include <stdint.h>
+#include <vector>
+#include <algorithm>
+
+namespace mic {
+namespace logger {
+
+/*!
+ * \brief Bounded lock-free queue with a fixed number of cells (D. Vyukov's sequence-per-cell algorithm).
+ * Safe for many producers and many consumers, although the logger uses a single consumer (the flush thread).
+ * Cells are never destroyed, so objects stored in them keep their (e.g. string) capacity between uses.
+ * \author tkornuta
+ * @tparam T Type of stored elements - must be default constructible and swappable.
+ */
+template <typename T>
+class RingBuffer {
+public:
+	/*!
+	 * Constructor. Allocates all the cells at once.
+	 * @param capacity_ Requested capacity, rounded up to the nearest power of two (minimum 2).
+	 */
+	RingBuffer(size_t capacity_) : cells(roundUp(capacity_)), mask(cells.size() - 1),
+		enqueue_pos(0), dequeue_pos(0)
+	{
+		for (size_t i = 0; i < cells.size(); i++)
+			cells[i].sequence.store(i, boost::memory_order_relaxed);
+	}
+
+	/*!
+	 * Tries to enqueue an element - the cell is filled by a functor, so the data is copied directly into the cell.
+	 * @param fill_ Functor called with reference to the reserved cell data.
+	 * @return False if the buffer is full.
+	 */
+	template <typename Filler>
+	bool tryPush(Filler & fill_) {
+		Cell* cell;
+		size_t pos = enqueue_pos.load(boost::memory_order_relaxed);
+		for (;;) {
+			cell = &cells[pos & mask];
+			size_t seq = cell->sequence.load(boost::memory_order_acquire);
+			intptr_t dif = (intptr_t)seq - (intptr_t)pos;
+			if (dif == 0) {
+				// Cell is free - try to reserve it.
+				if (enqueue_pos.compare_exchange_weak(pos, pos + 1, boost::memory_order_relaxed))
+					break;
+			} else if (dif < 0) {
+				// Buffer full.
+				return false;
+			} else
+				pos = enqueue_pos.load(boost::memory_order_relaxed);
+		}//: for
+
+		fill_(cell->data);
+		cell->sequence.store(pos + 1, boost::memory_order_release);
+		return true;
+	}
+
+	/*!
+	 * Tries to dequeue an element - swaps it with the content of the given object.
+	 * @param data_ Object to which the data will be moved.
+	 * @return False if the buffer is empty.
+	 */
+	bool tryPop(T & data_) {
+		Cell* cell;
+		size_t pos = dequeue_pos.load(boost::memory_order_relaxed);
+		for (;;) {
+			cell = &cells[pos & mask];
+			size_t seq = cell->sequence.load(boost::memory_order_acquire);
+			intptr_t dif = (intptr_t)seq - (intptr_t)(pos + 1);
+			if (dif == 0) {
+				// Cell is filled - try to take it.
+				if (dequeue_pos.compare_exchange_weak(pos, pos + 1, boost::memory_order_relaxed))
+					break;
+			} else if (dif < 0) {
+				// Buffer empty.
+				return false;
+			} else
+				pos = dequeue_pos.load(boost::memory_order_relaxed);
+		}//: for
+
+		using std::swap;
+		swap(data_, cell->data);
+		cell->sequence.store(pos + mask + 1, boost::memory_order_release);
+		return true;
+	}
+
+	/*!
+	 * Returns the capacity of the buffer.
+	 */
+	size_t capacity() const {
+		return cells.size();
+	}
+
+	/*!
+	 * Returns (approximate, if producers/consumers are working) number of elements in buffer.
+	 */
+	size_t size() const {
+		size_t e = enqueue_pos.load(boost::memory_order_relaxed);
+		size_t d = dequeue_pos.load(boost::memory_order_relaxed);
+		return (e > d) ? (e - d) : 0;
+	}
+
+private:
+	/*!
+	 * Cell of the buffer - data with its sequence number.
+	 */
+	struct Cell {
+		/// Sequence number, used for synchronization of producers and consumers.
+		boost::atomic<size_t> sequence;
+
+		/// Stored data.
+		T data;
+
+		Cell() : sequence(0) { }
+
+		Cell(const Cell & rhs) : sequence(rhs.sequence.load()), data(rhs.data) { }
+	};
+
+	/*!
+	 * Rounds the value up to the nearest power of two.
+	 */
+	static size_t roundUp(size_t val_) {
+		size_t res = 2;
+		while (res < val_)
+			res <<= 1;
+		return res;
+	}
+
+	/// Cells of the buffer.
+	std::vector<Cell> cells;
+
+	/// Mask used for wrapping the positions (capacity - 1).
+	const size_t mask;
+
+	/// Padding separating producer and consumer counters (avoids false sharing).
+	char pad0[64];
+
+	/// Position of next enqueue.
+	boost::atomic<size_t> enqueue_pos;
+
+	/// Padding separating producer and consumer counters (avoids false sharing).
+	char pad1[64];
+
+	/// Position of next dequeue.
+	boost::atomic<size_t> dequeue_pos;
+
+	/// Padding separating producer and consumer counters (avoids false sharing).
+	char pad2[64];
+
+	RingBuffer(const RingBuffer&);
+	RingBuffer& operator=(const RingBuffer&);
+};
+
+} /* namespace logger */
+} /* namespace mic */
+
+#endif /* SRC_LOGGER_RINGBUFFER_HPP_ */
@@ -25,6 +25,7 @@
 #define SCOPELOGGER_HPP_
 
 #include <logger/Logger.hpp>
+#include <logger/LogStream.hpp>
 
 namespace mic {
 namespace logger {
@@ -32,7 +33,8 @@ namespace logger {
 /*!
  * \class ScopeLogger
  * \brief Small class used to prepare line for logger.
- * Object created only for the purpose of parsing the ostringstream, during the macro LOG call.
+ * Object created only for the purpose of parsing the stream, during the macro LOG call.
+ * The message is formatted into the thread-local LogStream, so in steady state no memory is allocated.
  */
 class ScopeLogger
 {
@@ -40,12 +42,12 @@ public:
 	/*!
 	 * Constructor.
 	 * @param p_ Parent - "main" logger object.
-	 * @param f_ Name of the file which called the logger.
-	 * @param l_ Number of the file line in which the logger was called.
+	 * @param site_ Call site (file, line, function) of the logger.
 	 * @param s_ Log severity level.
+	 * @param suppressed_ Number of messages suppressed by the sampling macros (appended to the message when non-zero).
 	 */
-	ScopeLogger(Logger * p_, const std::string & f_, int l_, Severity_t s_) :
-		parent(p_), file(f_), line(l_), severity(s_)
+	ScopeLogger(Logger * p_, const LogSite & site_, Severity_t s_, uint64_t suppressed_ = 0) :
+		parent(p_), site(&site_), severity(s_), suppressed(suppressed_), os(LogStream::acquire())
 	{
 
 	}
@@ -54,30 +56,35 @@ public:
 	 * Destructor. Passes the retrieved data to parent logger.
 	 */
 	~ScopeLogger() {
-		parent->log(file, line, severity, os.str());
+		if (suppressed > 0) {
+			os->flags(std::ios_base::dec);
+			os->width(0);
+			(*os) << " [" << suppressed << " similar messages suppressed]";
+		}//: if
+		os->str();
+		os->record.site = site->id;
+		os->record.severity = severity;
+		os->record.binary = false;
+		os->record.timestamp = monotonicNs();
+		os->record.thread = threadId();
+		parent->log(os->record);
+		LogStream::release(os);
 	}
 
 	/*!
-	 * Returns the ostringstream object to which user can write.
+	 * Returns the stream object to which user can write.
 	 */
-	std::ostringstream& get()
+	std::ostream& get()
 	{
-		return os;
+		return *os;
 	}
 
-protected:
-	/*!
-	 * Ostringstream object storing the user comment.
-	 */
-	std::ostringstream os;
-
 private:
 	/*!
 	 * Default private constructor - sets parent
 	 * @param rhs
 	 */
-	ScopeLogger(const ScopeLogger & rhs) : parent(rhs.parent) {
-		line = -1;
+	ScopeLogger(const ScopeLogger & rhs) : parent(rhs.parent), site(NULL), suppressed(0), os(NULL) {
 		severity = LTRACE;
 	}
 
@@ -89,15 +96,18 @@ private:
 	/// Parent class, to which the information will be sent.
 	Logger * parent;
 
-	/// Name of the file which called the logger.
-	const std::string file;
-
-	/// Number of the file line in which the logger was called.
-	int line;
+	/// Call site of the logger.
+	const LogSite * site;
 
 	/// Log (message) severity.
 	Severity_t severity;
 
+	/// Number of suppressed messages.
+	uint64_t suppressed;
+
+	/// (Thread-local) stream storing the user comment.
+	LogStream * os;
+
 };
 
 
@@ -0,0 +1,154 @@
+/*!
+ * Copyright (C) tkornuta, IBM Corporation 2015-2019
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+/*!
+ * \file SharedMemoryOutput.cpp
+ * \brief Contains definitions of methods of the SharedMemoryOutput class.
+ * \author tkornuta
+ * \date Oct 17, 2026
+ */
+
+#include <logger/SharedMemoryOutput.hpp>
+
+#include <boost/thread/mutex.hpp>
+
+#include <stdexcept>
+#include <algorithm>
+#include <vector>
+#include <cerrno>
+#include <cstring>
+#include <cstdlib>
+
+#include <fcntl.h>
+#include <unistd.h>
+#include <sys/mman.h>
+
+namespace mic {
+namespace logger {
+
+namespace {
+
+/*!
+ * \brief Shared memory objects created by the process - unlinked at exit.
+ */
+struct CreatedObjects {
+	/// Mutex protecting the list.
+	boost::mutex mutex;
+
+	/// Names of the objects with the ids of the processes that created them (forked children do not unlink the objects of their parents).
+	std::vector<std::pair<std::string, int> > objects;
+
+	/// Flag denoting that the exit handler was registered.
+	bool registered;
+
+	CreatedObjects() : registered(false) { }
+};
+
+/*!
+ * Returns the list of created objects - never destroyed, so it can be used by the exit handler.
+ */
+CreatedObjects & createdObjects() {
+	static CreatedObjects * created = new CreatedObjects();
+	return *created;
+}
+
+/*!
+ * Unlinks the objects created by the process - the outputs are never destroyed by the logger.
+ */
+void unlinkAtExit() {
+	CreatedObjects & created = createdObjects();
+	boost::mutex::scoped_lock lock(created.mutex);
+	for (size_t i = 0; i < created.objects.size(); i++) {
+		if (created.objects[i].second == ::getpid())
+			shm_unlink(created.objects[i].first.c_str());
+	}//: for
+	created.objects.clear();
+}
+
+} /* namespace */
+
+SharedMemoryOutput::SharedMemoryOutput(const std::string & name_, size_t slots_, size_t slot_size_, Severity_t sev_) :
+	LoggerOutput(sev_), name(name_.empty() ? processName(::getpid()) : name_), data(NULL)
+{
+	size_t slots = std::max<size_t>(slots_, 1);
+	size_t slot_size = LogRing::slotSize(slot_size_);
+	size = LogRing::mappingSize(slots, slot_size);
+
+	// Create a new object, readable by the user only. Existing objects are not taken over - unless it is the per-process one,
+	// left by an exited process with the same pid (viewers attached to it notice that the name refers to another object).
+	int fd = shm_open(name.c_str(), O_RDWR | O_CREAT | O_EXCL, 0600);
+	if ((fd < 0) && (errno == EEXIST) && (name == processName(::getpid()))) {
+		shm_unlink(name.c_str());
+		fd = shm_open(name.c_str(), O_RDWR | O_CREAT | O_EXCL, 0600);
+	}//: if
+	if (fd < 0)
+		throw std::runtime_error("SharedMemoryOutput: cannot create shared memory object " + name + ": " + std::strerror(errno));
+	if (ftruncate(fd, size) != 0) {
+		::close(fd);
+		throw std::runtime_error("SharedMemoryOutput: cannot resize shared memory object " + name);
+	}//: if
+	void * ptr = mmap(NULL, size, PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+	::close(fd);
+	if (ptr == MAP_FAILED)
+		throw std::runtime_error("SharedMemoryOutput: cannot map shared memory object " + name);
+	data = (char*)ptr;
+	ring.reset(new LogRing(data, slots, slot_size));
+
+	// Remember the object, so it is unlinked at exit.
+	CreatedObjects & created = createdObjects();
+	boost::mutex::scoped_lock lock(created.mutex);
+	created.objects.push_back(std::make_pair(name, (int)::getpid()));
+	if (!created.registered) {
+		std::atexit(&unlinkAtExit);
+		created.registered = true;
+	}//: if
+}
+
+
+SharedMemoryOutput::~SharedMemoryOutput() {
+	munmap(data, size);
+	CreatedObjects & created = createdObjects();
+	boost::mutex::scoped_lock lock(created.mutex);
+	for (size_t i = 0; i < created.objects.size(); i++) {
+		if ((created.objects[i].first == name) && (created.objects[i].second == ::getpid())) {
+			shm_unlink(name.c_str());
+			created.objects.erase(created.objects.begin() + i);
+			break;
+		}//: if
+	}//: for
+}
+
+
+std::string SharedMemoryOutput::processName(int pid_) {
+	return "/mic_log." + std::to_string(pid_);
+}
+
+
+void SharedMemoryOutput::write(const LogRecord & rec_, const LogSite & site_) const {
+	ring->store(rec_.message.data(), rec_.message.size(), rec_.binary, rec_.severity, site_.file, site_.line, rec_.timestamp, rec_.thread);
+}
+
+
+void SharedMemoryOutput::print(const std::string & msg, Severity_t sev, const std::string & file, int line) const {
+	ring->store(msg.data(), msg.size(), false, sev, file.c_str(), line, monotonicNs(), threadId());
+}
+
+
+void SharedMemoryOutput::printBinary(const std::string & args, Severity_t sev, const std::string & file, int line) const {
+	ring->store(args.data(), args.size(), true, sev, file.c_str(), line, monotonicNs(), threadId());
+}
+
+} /* namespace logger */
+} /* namespace mic */
@@ -0,0 +1,125 @@
+/*!
+ * Copyright (C) tkornuta, IBM Corporation 2015-2019
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+/*!
+ * \file SharedMemoryOutput.hpp
+ * \brief Contains declaration of the SharedMemoryOutput class, publishing log records into a shared memory ring read by viewer processes.
+ * \author tkornuta
+ * \date Oct 17, 2026
+ */
+
+#ifndef SRC_LOGGER_SHAREDMEMORYOUTPUT_HPP_
+#define SRC_LOGGER_SHAREDMEMORYOUTPUT_HPP_
+
+#include <logger/LoggerOutput.hpp>
+#include <logger/LogRing.hpp>
+
+#include <boost/scoped_ptr.hpp>
+
+#include <string>
+
+namespace mic {
+namespace logger {
+
+/*!
+ * \brief Output publishing the records into a ring (see LogRing) in a POSIX shared memory object.
+ * The records are formatted, coloured and printed by separate viewer processes (mic_logview), so the logging threads
+ * never block on a slow terminal. Any number of viewers can attach and detach at any time - they only read the ring,
+ * and when a viewer falls behind the records it missed are overwritten (the producer never waits).
+ * By default every process publishes into its own object (/mic_log.<pid>), readable by its user only (mode 0600).
+ * The object is removed (unlinked) when the output is destroyed or when the process exits, so short-lived processes do not fill /dev/shm -
+ * viewers attached at that time keep their mapping and can still read the tail of the log. An existing object of another name is never taken over.
+ * \author tkornuta
+ */
+class SharedMemoryOutput : public LoggerOutput {
+public:
+	/*!
+	 * Constructor. Creates the shared memory object and maps it into memory.
+	 * Throws std::runtime_error if the object already exists - with the exception of the default (per-process) name,
+	 * whose existing object can only be left by an exited process with the same pid.
+	 * @param name_ Name of the shared memory object (empty - the per-process name, see processName()).
+	 * @param slots_ Number of slots of the ring.
+	 * @param slot_size_ Size of the slot in bytes (longer messages are truncated).
+	 * @param sev_ Output severity level (LINFO as default).
+	 */
+	SharedMemoryOutput(const std::string & name_ = "", size_t slots_ = 16384, size_t slot_size_ = 256, Severity_t sev_ = LINFO);
+
+	/*!
+	 * Destructor. Unmaps and unlinks the shared memory object.
+	 */
+	virtual ~SharedMemoryOutput();
+
+	/*!
+	 * Returns the default name of the shared memory object of the process.
+	 * @param pid_ Id of the process.
+	 * @return Name "/mic_log.<pid>".
+	 */
+	static std::string processName(int pid_);
+
+	/*!
+	 * Publishes the record.
+	 * @param rec_ Record.
+	 * @param site_ Call site of the record.
+	 */
+	void write(const LogRecord & rec_, const LogSite & site_) const;
+
+	/*!
+	 * Publishes the message.
+	 * @param msg Message to be published.
+	 * @param sev Severity level.
+	 * @param file File that called the log function.
+	 * @param line Line in which log function was called.
+	 */
+	void print(const std::string & msg, Severity_t sev, const std::string & file, int line) const;
+
+	/*!
+	 * Publishes the message with binary arguments (arguments are formatted by the viewers).
+	 * @param args Binary arguments.
+	 * @param sev Severity level.
+	 * @param file File that called the log function.
+	 * @param line Line in which log function was called.
+	 */
+	void printBinary(const std::string & args, Severity_t sev, const std::string & file, int line) const;
+
+	/*!
+	 * Does nothing - the records are visible to the viewers as soon as they are published.
+	 */
+	void endOfBatch() { }
+
+	/*!
+	 * Returns the name of the shared memory object.
+	 */
+	const std::string & getName() const {
+		return name;
+	}
+
+private:
+	/// Name of the shared memory object.
+	std::string name;
+
+	/// Mapped memory.
+	char * data;
+
+	/// Size of the mapped memory.
+	size_t size;
+
+	/// Ring in the mapped memory.
+	boost::scoped_ptr<LogRing> ring;
+};
+
+} /* namespace logger */
+} /* namespace mic */
+
+#endif /* SRC_LOGGER_SHAREDMEMORYOUTPUT_HPP_ */
@@ -0,0 +1,377 @@
+/*!
+ * Copyright (C) tkornuta, IBM Corporation 2015-2019
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+/*!
+ * \file logger_benchmark.cpp
+ * \brief Benchmark of the logger - measures the cost of enabled and disabled LOG statements, throughput with many threads,
+ * latency percentiles and allocations per message for every logger output, and prints the results as JSON.
+ * \author tkornuta
+ * \date Oct 17, 2026
+ */
+
+#include <logger/Log.hpp>
+#include <logger/ConsoleOutput.hpp>
+#include <logger/FileOutput.hpp>
+#include <logger/BinaryFileOutput.hpp>
+#include <logger/FlightRecorderOutput.hpp>
+#include <logger/SharedMemoryOutput.hpp>
+#include <logger/JsonLinesOutput.hpp>
+#ifdef MIC_HAVE_ZLIB
+#include <logger/CompressedFileOutput.hpp>
+#endif
+
+#include <boost/atomic.hpp>
+#include <boost/thread/thread.hpp>
+#include <boost/thread/barrier.hpp>
+
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <fstream>
+#include <iostream>
+#include <new>
+#include <sstream>
+#include <string>
+#include <vector>
+
+#include <unistd.h>
+
+using namespace mic::logger;
+
+/// Capacity of the queue of the asynchronous logger.
+static const size_t async_capacity = 1 << 16;
+
+/// Number of allocations done by the process (counted by the replaced operator new).
+static boost::atomic<uint64_t> allocations(0);
+
+/*!
+ * Allocates the memory and counts the allocation - used by all replaced forms of the global operator new.
+ * Not inlined (as all the replaced operators), so the compiler does not pair the inlined malloc/free with new/delete expressions.
+ */
+__attribute__((noinline)) static void * countedAlloc(size_t size_) noexcept {
+	allocations.fetch_add(1, boost::memory_order_relaxed);
+	return std::malloc(size_ ? size_ : 1);
+}
+
+/*!
+ * Frees the memory allocated by countedAlloc().
+ */
+__attribute__((noinline)) static void countedFree(void * ptr_) noexcept {
+	std::free(ptr_);
+}
+
+/*
+ * Complete set of the replaceable global allocation and deallocation functions (C++11/14) - counting the allocations.
+ */
+__attribute__((noinline)) void * operator new(size_t size_) {
+	void * ptr = countedAlloc(size_);
+	if (!ptr)
+		throw std::bad_alloc();
+	return ptr;
+}
+
+__attribute__((noinline)) void * operator new[](size_t size_) {
+	void * ptr = countedAlloc(size_);
+	if (!ptr)
+		throw std::bad_alloc();
+	return ptr;
+}
+
+__attribute__((noinline)) void * operator new(size_t size_, const std::nothrow_t &) noexcept {
+	return countedAlloc(size_);
+}
+
+__attribute__((noinline)) void * operator new[](size_t size_, const std::nothrow_t &) noexcept {
+	return countedAlloc(size_);
+}
+
+__attribute__((noinline)) void operator delete(void * ptr_) noexcept {
+	countedFree(ptr_);
+}
+
+__attribute__((noinline)) void operator delete[](void * ptr_) noexcept {
+	countedFree(ptr_);
+}
+
+__attribute__((noinline)) void operator delete(void * ptr_, const std::nothrow_t &) noexcept {
+	countedFree(ptr_);
+}
+
+__attribute__((noinline)) void operator delete[](void * ptr_, const std::nothrow_t &) noexcept {
+	countedFree(ptr_);
+}
+
+__attribute__((noinline)) void operator delete(void * ptr_, size_t) noexcept {
+	countedFree(ptr_);
+}
+
+__attribute__((noinline)) void operator delete[](void * ptr_, size_t) noexcept {
+	countedFree(ptr_);
+}
+
+
+/// Clock used for measurements.
+typedef std::chrono::steady_clock Clock;
+
+/*!
+ * Returns the time elapsed since given point in nanoseconds.
+ */
+inline double elapsedNs(Clock::time_point start_) {
+	return (double)std::chrono::duration_cast<std::chrono::nanoseconds>(Clock::now() - start_).count();
+}
+
+/*!
+ * \brief Output discarding all messages - measures the cost of the logger itself.
+ */
+class NullOutput : public LoggerOutput {
+public:
+	NullOutput(Severity_t sev_ = LINFO) : LoggerOutput(sev_) { }
+
+	void print(const std::string &, Severity_t, const std::string &, int) const { }
+
+	void printBinary(const std::string &, Severity_t, const std::string &, int) const { }
+};
+
+/*!
+ * \brief Stream buffer discarding everything - the console output is redirected into it during the measurements.
+ */
+class NullBuffer : public std::streambuf {
+protected:
+	int overflow(int c_) {
+		return c_;
+	}
+
+	std::streamsize xsputn(const char *, std::streamsize n_) {
+		return n_;
+	}
+};
+
+/*!
+ * \brief Results of the benchmark of a single output.
+ */
+struct Result {
+	/// Name of the output.
+	std::string output;
+
+	/// Mode of the logger (sync/async).
+	std::string mode;
+
+	/// Cost of the disabled statement [ns].
+	double disabled_ns;
+
+	/// Cost of the enabled statement [ns].
+	double enabled_ns;
+
+	/// Cost of the enabled binary (BLOG) statement [ns].
+	double enabled_binary_ns;
+
+	/// Allocations per message.
+	double allocs_per_msg;
+
+	/// Latency percentiles [ns].
+	double p50, p99, p999;
+
+	/// Pairs (number of threads, messages per second).
+	std::vector<std::pair<unsigned, double> > throughput;
+};
+
+/*!
+ * Logs a typical message.
+ */
+inline void logMessage(uint64_t i_) {
+	LOG(LINFO) << "Iteration " << i_ << " loss " << 0.125 * (double)i_ << " state " << "running";
+}
+
+/*!
+ * Logs a message below the level of outputs.
+ */
+inline void logDisabled(uint64_t i_) {
+	LOG(LTRACE) << "Iteration " << i_ << " loss " << 0.125 * (double)i_ << " state " << "running";
+}
+
+/*!
+ * Logs a typical message in binary form.
+ */
+inline void logBinaryMessage(uint64_t i_) {
+	BLOG(LINFO) << "Iteration " << i_ << " loss " << 0.125 * (double)i_ << " state " << "running";
+}
+
+/*!
+ * Returns the given percentile of the sorted samples.
+ */
+double percentile(const std::vector<double> & sorted_, double p_) {
+	size_t idx = (size_t)(p_ * (double)(sorted_.size() - 1));
+	return sorted_[idx];
+}
+
+/*!
+ * Runs all measurements for the output (already added to the logger).
+ * @param output_ Output.
+ * @param name_ Name of the output.
+ * @param async_ Asynchronous mode of the logger.
+ * @param iterations_ Number of messages per measurement.
+ * @param max_threads_ Maximal number of logging threads.
+ */
+Result benchmark(LoggerOutput * output_, const std::string & name_, bool async_, uint64_t iterations_, unsigned max_threads_) {
+	Result res;
+	res.output = name_;
+	res.mode = async_ ? "async" : "sync";
+	if (async_)
+		LOGGER->startAsync(async_capacity, BlockOnOverflow);
+
+	// Warm up - registers the sites, grows the thread-local streams and buffers.
+	// Every cell of the asynchronous queue is used at least once, so its buffers are grown before the measurements.
+	for (uint64_t i = 0; i < async_capacity; i++) {
+		logMessage(i);
+		logBinaryMessage(i);
+		logDisabled(i);
+	}//: for
+	LOGGER->flush();
+
+	Clock::time_point start = Clock::now();
+	for (uint64_t i = 0; i < iterations_; i++)
+		logDisabled(i);
+	res.disabled_ns = elapsedNs(start) / iterations_;
+
+	uint64_t allocs = allocations.load();
+	start = Clock::now();
+	for (uint64_t i = 0; i < iterations_; i++)
+		logMessage(i);
+	LOGGER->flush();
+	res.enabled_ns = elapsedNs(start) / iterations_;
+	res.allocs_per_msg = (double)(allocations.load() - allocs) / iterations_;
+
+	start = Clock::now();
+	for (uint64_t i = 0; i < iterations_; i++)
+		logBinaryMessage(i);
+	LOGGER->flush();
+	res.enabled_binary_ns = elapsedNs(start) / iterations_;
+
+	// Latency of single statements (includes the cost of reading the clock).
+	std::vector<double> samples(iterations_);
+	for (uint64_t i = 0; i < iterations_; i++) {
+		Clock::time_point t = Clock::now();
+		logMessage(i);
+		samples[i] = elapsedNs(t);
+	}//: for
+	LOGGER->flush();
+	std::sort(samples.begin(), samples.end());
+	res.p50 = percentile(samples, 0.5);
+	res.p99 = percentile(samples, 0.99);
+	res.p999 = percentile(samples, 0.999);
+
+	// Throughput - the same number of messages logged by 1, 2, 4 ... threads.
+	for (unsigned threads = 1; threads <= max_threads_; threads *= 2) {
+		boost::barrier barrier(threads + 1);
+		boost::thread_group group;
+		uint64_t per_thread = iterations_ / threads;
+		for (unsigned t = 0; t < threads; t++)
+			group.create_thread([&barrier, per_thread]() {
+				barrier.wait();
+				for (uint64_t i = 0; i < per_thread; i++)
+					logMessage(i);
+			});
+		barrier.wait();
+		start = Clock::now();
+		group.join_all();
+		LOGGER->flush();
+		res.throughput.push_back(std::make_pair(threads, (double)(per_thread * threads) * 1e9 / elapsedNs(start)));
+	}//: for
+
+	if (async_)
+		LOGGER->stopAsync();
+	// Outputs cannot be removed from the logger - disable it for the following benchmarks.
+	output_->setLvl(LFATAL);
+	return res;
+}
+
+/*!
+ * Prints the results as JSON.
+ */
+void printJson(std::ostream & os_, const std::vector<Result> & results_, uint64_t iterations_, unsigned max_threads_) {
+	os_ << "{\n  \"iterations\": " << iterations_ << ",\n  \"max_threads\": " << max_threads_ << ",\n  \"results\": [\n";
+	for (size_t r = 0; r < results_.size(); r++) {
+		const Result & res = results_[r];
+		os_ << "    {\"output\": \"" << res.output << "\", \"mode\": \"" << res.mode << "\""
+			<< ", \"disabled_ns\": " << res.disabled_ns
+			<< ", \"enabled_ns\": " << res.enabled_ns
+			<< ", \"enabled_binary_ns\": " << res.enabled_binary_ns
+			<< ", \"allocs_per_msg\": " << res.allocs_per_msg
+			<< ", \"latency_ns\": {\"p50\": " << res.p50 << ", \"p99\": " << res.p99 << ", \"p999\": " << res.p999 << "}"
+			<< ", \"throughput_msgs_per_s\": {";
+		for (size_t i = 0; i < res.throughput.size(); i++)
+			os_ << (i ? ", " : "") << "\"" << res.throughput[i].first << "\": " << res.throughput[i].second;
+		os_ << "}}" << ((r + 1 < results_.size()) ? "," : "") << "\n";
+	}//: for
+	os_ << "  ]\n}\n";
+}
+
+
+/*!
+ * \brief Main program function - runs the benchmark of all logger outputs.
+ * \author tkornuta
+ * @param[in] argc Number of parameters.
+ * @param[in] argv List of parameters: number of messages per measurement, maximal number of threads and name of the JSON file (stdout by default).
+ * @return 0 on success, 1 on error.
+ */
+int main(int argc, char* argv[]) {
+	uint64_t iterations = (argc > 1) ? std::strtoull(argv[1], NULL, 10) : 200000;
+	unsigned max_threads = (argc > 2) ? (unsigned)std::atoi(argv[2]) : std::min(8u, std::max(1u, boost::thread::hardware_concurrency()));
+	if ((iterations == 0) || (max_threads == 0)) {
+		std::cerr << "Usage: " << argv[0] << " [messages per measurement] [maximal number of threads] [output JSON file]\n";
+		return 1;
+	}//: if
+
+	// Console output is redirected into the null buffer.
+	NullBuffer null_buffer;
+	std::streambuf * cout_buffer = std::cout.rdbuf(&null_buffer);
+
+	std::vector<Result> results;
+	for (int async = 0; async < 2; async++) {
+		std::string suffix = async ? ".async" : ".sync";
+		std::remove(("logger_benchmark" + suffix + ".log").c_str());
+		std::remove(("logger_benchmark" + suffix + ".blog").c_str());
+		std::remove(("logger_benchmark" + suffix + ".ring").c_str());
+		std::remove(("logger_benchmark" + suffix + ".ring.prev").c_str());
+		std::remove(("logger_benchmark" + suffix + ".jsonl").c_str());
+		std::remove(("logger_benchmark" + suffix + ".log.gz").c_str());
+
+		std::vector<std::pair<LoggerOutput*, std::string> > outputs;
+		outputs.push_back(std::make_pair(new NullOutput(), "null"));
+		outputs.push_back(std::make_pair(new ConsoleOutput(), "console"));
+		outputs.push_back(std::make_pair(new FileOutput("logger_benchmark" + suffix + ".log"), "file"));
+		outputs.push_back(std::make_pair(new BinaryFileOutput("logger_benchmark" + suffix + ".blog"), "binary_file"));
+		outputs.push_back(std::make_pair(new FlightRecorderOutput("logger_benchmark" + suffix + ".ring", 4096, 256, LINFO), "flight_recorder"));
+		outputs.push_back(std::make_pair(new SharedMemoryOutput(SharedMemoryOutput::processName(getpid()) + suffix), "shared_memory"));
+		outputs.push_back(std::make_pair(new JsonLinesOutput("logger_benchmark" + suffix + ".jsonl"), "json_lines"));
+#ifdef MIC_HAVE_ZLIB
+		outputs.push_back(std::make_pair(new CompressedFileOutput("logger_benchmark" + suffix + ".log.gz"), "gzip_file"));
+#endif
+		for (size_t o = 0; o < outputs.size(); o++) {
+			LOGGER->addOutput(outputs[o].first);
+			results.push_back(benchmark(outputs[o].first, outputs[o].second, async != 0, iterations, max_threads));
+			std::cerr << outputs[o].second << " (" << results.back().mode << "): " << results.back().enabled_ns << " ns/msg\n";
+		}//: for
+	}//: for
+
+	std::cout.rdbuf(cout_buffer);
+	if (argc > 3) {
+		std::ofstream out(argv[3]);
+		printJson(out, results, iterations, max_threads);
+	} else
+		printJson(std::cout, results, iterations, max_threads);
+	return 0;
+}
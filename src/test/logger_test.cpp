@@ -38,6 +38,7 @@ using namespace mic::logger;
 int main(int argc, char* argv[]) {
 	// Set console output.
 	ConsoleOutput* co = new ConsoleOutput();
+	co->setTimestamps(true);
 	LOGGER->addOutput(co);
 
 	// Set initial logger level.
@@ -0,0 +1,129 @@
+/*!
+ * Copyright (C) tkornuta, IBM Corporation 2015-2019
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+/*!
+ * \file mic_logdecode.cpp
+ * \brief Program decoding binary log files (written by BinaryFileOutput) into console text.
+ * \author tkornuta
+ * \date Oct 17, 2026
+ */
+
+#include <logger/ConsoleOutput.hpp>
+#include <logger/BinaryFormat.hpp>
+#include <logger/LogClock.hpp>
+
+#include <fstream>
+#include <iterator>
+#include <map>
+#include <cstdlib>
+#include <cstdio>
+
+using namespace mic::logger;
+
+/*!
+ * \brief Call site read from the binary log.
+ */
+struct Site {
+	std::string file;
+	int line;
+};
+
+
+/*!
+ * \brief Main program function - decodes the binary log and prints it as ConsoleOutput does, prefixed with the time of logging.
+ * \author tkornuta
+ * @param[in] argc Number of parameters.
+ * @param[in] argv List of parameters: name of the binary log file and optional minimal severity level.
+ * @return 0 on success, 1 on error.
+ */
+int main(int argc, char* argv[]) {
+	if (argc < 2) {
+		std::cerr << "Usage: " << argv[0] << " <binary log file> [minimal severity level (0-7)]\n";
+		return 1;
+	}//: if
+
+	// Read the whole file.
+	std::ifstream in(argv[1], std::ios::binary);
+	if (!in) {
+		std::cerr << "Cannot open file " << argv[1] << "\n";
+		return 1;
+	}//: if
+	std::string data((std::istreambuf_iterator<char>(in)), std::istreambuf_iterator<char>());
+
+	if ((data.size() < binary::magic_length) || (data.compare(0, binary::magic_length, binary::magic) != 0)) {
+		std::cerr << argv[1] << " is not a binary MIC log file\n";
+		return 1;
+	}//: if
+
+	ConsoleOutput console((argc > 2) ? (Severity_t)std::atoi(argv[2]) : LTRACE);
+
+	// Offset of the wall-clock time from the timestamps (files without the clock record print the raw timestamps).
+	bool has_clock = false;
+	int64_t clock_offset = 0;
+
+	std::map<uint32_t, Site> sites;
+	const char * ptr = data.data() + binary::magic_length;
+	const char * end = data.data() + data.size();
+	while (ptr < end) {
+		char type = *ptr++;
+		if (type == binary::ClockRecord) {
+			if (!binary::readRaw(ptr, end, clock_offset))
+				break;
+			has_clock = true;
+		} else if (type == binary::SiteRecord) {
+			uint32_t id;
+			int32_t line;
+			uint16_t len;
+			if (!binary::readRaw(ptr, end, id) || !binary::readRaw(ptr, end, line) || !binary::readRaw(ptr, end, len) || ((size_t)(end - ptr) < len))
+				break;
+			Site & site = sites[id];
+			site.file.assign(ptr, len);
+			site.line = line;
+			ptr += len;
+		} else if (type == binary::MessageRecord) {
+			uint32_t id;
+			uint64_t ts;
+			uint8_t sev;
+			uint32_t len;
+			if (!binary::readRaw(ptr, end, id) || !binary::readRaw(ptr, end, ts) || !binary::readRaw(ptr, end, sev) ||
+					!binary::readRaw(ptr, end, len) || ((size_t)(end - ptr) < len))
+				break;
+			if ((Severity_t)sev >= console.getLvl()) {
+				const Site & site = sites[id];
+				// Time at which the message was logged.
+				char stamp[timestamp_length];
+				size_t stamp_len;
+				if (has_clock)
+					stamp_len = formatWallClock((int64_t)ts + clock_offset, stamp);
+				else
+					stamp_len = std::snprintf(stamp, sizeof(stamp), "%llu.%09llu", (unsigned long long)(ts / 1000000000), (unsigned long long)(ts % 1000000000));
+				std::cout.write(stamp, stamp_len);
+				std::cout << ' ';
+				console.print(binary::formatArguments(std::string(ptr, len)), (Severity_t)sev, site.file, site.line);
+			}//: if
+			ptr += len;
+		} else {
+			std::cerr << "Corrupted record at offset " << (ptr - 1 - data.data()) << "\n";
+			return 1;
+		}//: else
+	}//: while
+
+	console.flush();
+	if (ptr < end) {
+		std::cerr << "Truncated record at the end of file\n";
+		return 1;
+	}//: if
+	return 0;
+}//: main
@@ -0,0 +1,47 @@
+/*!
+ * Copyright (C) tkornuta, IBM Corporation 2015-2019
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+/*!
+ * \file mic_logdump.cpp
+ * \brief Program dumping the records kept in the ring file of the flight recorder (see FlightRecorderOutput).
+ * \author tkornuta
+ * \date Oct 17, 2026
+ */
+
+#include <logger/FlightRecorderOutput.hpp>
+
+#include <iostream>
+
+using namespace mic::logger;
+
+/*!
+ * \brief Main program function - prints the records of the flight recorder, from the oldest one.
+ * \author tkornuta
+ * @param[in] argc Number of parameters.
+ * @param[in] argv List of parameters: name of the ring file.
+ * @return 0 on success, 1 on error.
+ */
+int main(int argc, char* argv[]) {
+	if (argc < 2) {
+		std::cerr << "Usage: " << argv[0] << " <flight recorder file>\n";
+		return 1;
+	}//: if
+
+	if (!FlightRecorderOutput::dumpFile(argv[1], std::cout)) {
+		std::cerr << argv[1] << " cannot be read or is not a flight recorder file\n";
+		return 1;
+	}//: if
+	return 0;
+}
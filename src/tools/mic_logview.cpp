@@ -0,0 +1,192 @@
+/*!
+ * Copyright (C) tkornuta, IBM Corporation 2015-2019
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+/*!
+ * \file mic_logview.cpp
+ * \brief Viewer of the log records published into shared memory by the SharedMemoryOutput - filters, colours and prints them.
+ * \author tkornuta
+ * \date Oct 17, 2026
+ */
+
+#include <logger/ConsoleOutput.hpp>
+#include <logger/LogRing.hpp>
+#include <logger/SharedMemoryOutput.hpp>
+
+#include <iostream>
+#include <string>
+#include <cstdlib>
+#include <algorithm>
+
+#include <fcntl.h>
+#include <unistd.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+
+using namespace mic::logger;
+
+/*!
+ * \brief Read-only mapping of the shared memory object containing the ring.
+ */
+struct Attachment {
+	/// Mapped memory.
+	char * data;
+
+	/// Size of the mapping.
+	size_t size;
+
+	/// Inode of the object - changes when the producer recreates the object.
+	ino_t inode;
+
+	Attachment() : data(NULL), size(0), inode(0) { }
+
+	/*!
+	 * Maps the shared memory object.
+	 * @return False if the object does not exist (yet).
+	 */
+	bool attach(const std::string & name_) {
+		int fd = shm_open(name_.c_str(), O_RDONLY, 0);
+		if (fd < 0)
+			return false;
+		struct stat st;
+		if ((fstat(fd, &st) != 0) || (st.st_size == 0)) {
+			::close(fd);
+			return false;
+		}//: if
+		void * ptr = mmap(NULL, st.st_size, PROT_READ, MAP_SHARED, fd, 0);
+		::close(fd);
+		if (ptr == MAP_FAILED)
+			return false;
+		data = (char*)ptr;
+		size = st.st_size;
+		inode = st.st_ino;
+		return true;
+	}
+
+	/*!
+	 * Unmaps the object.
+	 */
+	void detach() {
+		if (data)
+			munmap(data, size);
+		data = NULL;
+	}
+
+	/*!
+	 * Returns true if the name refers to another object than the mapped one (i.e. the producer was restarted).
+	 */
+	bool replaced(const std::string & name_) const {
+		int fd = shm_open(name_.c_str(), O_RDONLY, 0);
+		if (fd < 0)
+			return false;
+		struct stat st;
+		bool other = (fstat(fd, &st) == 0) && (st.st_ino != inode);
+		::close(fd);
+		return other;
+	}
+};
+
+
+/*!
+ * \brief Main program function - attaches to the shared memory ring and prints the records as they arrive.
+ * \author tkornuta
+ * @param[in] argc Number of parameters.
+ * @param[in] argv List of parameters (see usage).
+ * @return 0 on success, 1 on error.
+ */
+int main(int argc, char* argv[]) {
+	std::string name;
+	std::string filter;
+	Severity_t min_sev = LTRACE;
+	bool from_start = false;
+	int opt;
+	while ((opt = getopt(argc, argv, "n:p:l:f:a")) != -1) {
+		switch (opt) {
+		case 'n': name = optarg; break;
+		case 'p': name = SharedMemoryOutput::processName(std::atoi(optarg)); break;
+		case 'l': if (!str2sev(optarg, min_sev)) { std::cerr << "Invalid severity level " << optarg << "\n"; return 1; } break;
+		case 'f': filter = optarg; break;
+		case 'a': from_start = true; break;
+		default:
+			name.clear();
+			optind = argc;
+		}//: switch
+	}//: while
+	if (name.empty()) {
+		std::cerr << "Usage: " << argv[0] << " -p producer pid | -n shared memory name [-l minimal severity level] [-f text the file or message must contain] [-a (print the records kept in the ring first)]\n";
+		return 1;
+	}//: if
+
+	ConsoleOutput console(min_sev);
+	Attachment att;
+	RingEntry entry;
+	for (;;) {
+		// Wait for the producer - all its records are printed then.
+		while (!att.attach(name)) {
+			from_start = true;
+			usleep(200000);
+		}//: while
+		LogRing ring(att.data, att.size);
+		if (!ring.valid()) {
+			att.detach();
+			usleep(200000);
+			continue;
+		}//: if
+
+		uint64_t next = ring.next();
+		uint64_t seq = (!from_start) ? next : ((next > ring.getSlots()) ? next - ring.getSlots() : 0);
+		// Records of the restarted producer are printed from the beginning.
+		from_start = true;
+		unsigned idle = 0, stalled = 0;
+		for (;;) {
+			RingRead_t res = ring.read(seq, entry);
+			if (res == RingOk) {
+				seq++;
+				idle = stalled = 0;
+				if (entry.severity < min_sev)
+					continue;
+				std::string msg = entry.text();
+				if (!filter.empty() && (msg.find(filter) == std::string::npos) && (entry.file.find(filter) == std::string::npos))
+					continue;
+				if (entry.truncated)
+					msg += " [truncated]";
+				char time[timestamp_length];
+				std::cout.write(time, formatWallClock(entry.wall_time, time));
+				std::cout << " #" << entry.thread << " ";
+				console.print(msg, entry.severity, entry.file, entry.line);
+			} else if (res == RingOverwritten) {
+				// The viewer fell behind - continue with the oldest record kept.
+				next = ring.next();
+				uint64_t oldest = (next > ring.getSlots()) ? next - ring.getSlots() : 0;
+				std::cout << yellow << "[" << ((oldest > seq) ? oldest - seq : 1) << " records lost]" << reset << '\n';
+				seq = std::max(oldest, seq + 1);
+			} else if ((ring.next() > seq) && (++stalled < 1000)) {
+				// Record being written.
+				continue;
+			} else if (ring.next() > seq) {
+				// The writer of the record died - skip it.
+				seq++;
+				stalled = 0;
+			} else {
+				std::cout.flush();
+				usleep(10000);
+				if ((++idle % 100 == 0) && att.replaced(name))
+					break;
+			}//: else
+		}//: for
+		att.detach();
+		std::cout << yellow << "[producer restarted]" << reset << std::endl;
+	}//: for
+	return 0;
+}